@@ -4,35 +4,170 @@
  * SPDX-License-Identifier: GPL-3.0-or-later
  */
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
-#include "hex-ai/Util/LRUCache.hpp"
+#include "hex-ai/GameSolve/Budget.hpp"
+#include "hex-ai/GameSolve/InferiorCells.hpp"
+#include "hex-ai/GameSolve/MoveOrdering.hpp"
+#include "hex-ai/GameSolve/SolveResult.hpp"
+#include "hex-ai/GameSolve/TranspositionTable.hpp"
+#include "hex-ai/Io/SolvedDatabase0.hpp"
 #include "hex-ai/GameState/HexState.hpp"
-#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
 #include "hex-ai/GameState/enums.hpp"
 
 namespace GameSolve {
 
 /**
 * AlphaBeta2PlayersCached is a class that provides functions to run
-* the alpha beta algorithm on a game of Hex
+* the alpha beta algorithm on a game of Hex.
+* The order moves are tried in at each node is up to `Ordering`
+* (see MoveOrdering), and moves which InferiorCells shows can't be
+* any better than another move are skipped unless told otherwise.
+* If it is given a database of solved states (see Io::SolvedDatabase0),
+* states found there are never searched.
+*
+* What has been solved is kept in a TranspositionTable, keyed on the
+* Zobrist key of the stones alone, which can be shared between solvers
+* on several threads. An entry is worth as much as the log of the amount
+* of nodes it took to solve. Along with who wins, every entry keeps
+* the winning move of the player to move, if they have one.
+*
+* solve also works out the least amount of moves the winner needs,
+* which takes a search of its own: one that asks whether the winner can
+* win within 1, 3, 5, ... moves (or 2, 4, ... if it is the loser's turn),
+* and can't skip inferior moves, since those keep who wins but not how quickly.
+* What it finds out is kept in the same table as everything else (see Lengths),
+* so it costs no memory of its own, but it costs more nodes than who wins does.
 */
-template<int bsize>
+template<int bsize, class Ordering = MoveOrdering<bsize>>
 struct AlphaBeta2PlayersCached {
 public:
+    using Position = typename GameState::HexState<bsize>::Position;
+
+    // how many bits the move of an Entry takes
+    static constexpr int move_bits =
+        std::bit_width(GameState::PackedAction(bsize * bsize - 1, GameState::PLAYER_TWO).bits);
+    static_assert(
+        move_bits + 1 <= TranspositionTable::data_bits,
+        "every Entry has to fit in the data of a TranspositionTable entry"
+    );
+    // whether solve can work out how many moves a win takes, which it can
+    // if half the cells of the board fit in a byte (see Lengths)
+    static constexpr bool tracks_plies = bsize * bsize / 2 < 255;
+
+    /**
+    * What the table remembers about a state: whether player one wins,
+    * and the winning move of the player to move, if they have one.
+    * A state found in the database, or won already, has no move.
+    * The move is in the orientation of the table key.
+    */
+    struct Entry {
+        bool one_wins = false;
+        GameState::PackedAction best;
+
+        // an entry in the bits of TranspositionTable data, and back
+        uint16_t pack() const {
+            return static_cast<uint16_t>(this->best.bits << 1 | this->one_wins);
+        }
+
+        static Entry unpack(uint16_t data) {
+            Entry entry;
+            entry.one_wins = data & 1;
+            entry.best.bits = static_cast<uint16_t>(data >> 1);
+            return entry;
+        }
+    };
+
+    /**
+    * What the table remembers about how quickly one player can win a state.
+    * How many moves (of both players) a win takes is odd if it is the winner's
+    * turn and even if it isn't, so it is kept as half of that, rounded down.
+    * No win takes less than at_least, and some win takes no more than at_most,
+    * which is `none` until one is found.
+    * These are kept under the key of the state mixed with the player
+    * (see lengths_key), so they never get mistaken for an Entry.
+    */
+    struct Lengths {
+        static constexpr int none = 255;
+        int at_least = 0;
+        int at_most = none;
+
+        uint16_t pack() const {
+            return static_cast<uint16_t>(this->at_most << 8 | this->at_least);
+        }
+
+        static Lengths unpack(uint16_t data) {
+            Lengths lengths;
+            lengths.at_least = data & 255;
+            lengths.at_most = data >> 8;
+            return lengths;
+        }
+    };
+
     // tracks how many nodes have been expanded 
     long nodes_expanded = 0;
-    // internal cache of nodes
-    Cache::LRUCache<GameState::HexState<bsize>, bool> cache;
+private:
+    std::unique_ptr<TranspositionTable> owned;
+
+public:
+    // what has been solved so far, keyed on the stones of each state alone
+    TranspositionTable &table;
+    // whether the cache is keyed on the canonical orientation of each state
+    bool use_symmetry;
+    // decides which moves to try first
+    Ordering ordering;
+    // whether moves shown to be inferior by InferiorCells are skipped
+    bool prune_inferior;
+    // states solved ahead of time, looked up before searching them, or nullptr
+    // (which it always is on boards over 5x5)
+    const Io::SolvedDatabase0Reader<bsize> *database = nullptr;
 
 public:
     /**
     * The constructor takes a single parameter to tell us how large to make
     * the internal cache for storing past gamestates.
     *
-    * @param cache_size the size of the internal cache for past gamestates.
+    * @param cache_size the amount of entries in the transposition table
+    *                   (see TranspositionTable for how it is rounded).
+    * @param use_symmetry whether a state and its 180 degree rotation
+    *                     should share a single entry in the cache
+    *                     (see HexState::canonical).
+    * @param ordering decides which moves to try first.
+    * @param prune_inferior whether to skip moves that InferiorCells shows
+    *                       can't be any better than another move.
+    */
+    AlphaBeta2PlayersCached(
+        unsigned int cache_size,
+        bool use_symmetry = false,
+        Ordering ordering = Ordering(),
+        bool prune_inferior = true
+    ) : owned(std::make_unique<TranspositionTable>(cache_size)), table(*this->owned),
+        use_symmetry(use_symmetry), ordering(ordering), prune_inferior(prune_inferior) {};
+
+    /**
+    * @param table a transposition table to share with other solvers
+    *              (on any thread), which must outlive this one.
+    *              Solvers sharing a table must agree on `use_symmetry`.
+    * @param use_symmetry as above.
+    * @param ordering as above.
+    * @param prune_inferior as above.
     */
-    AlphaBeta2PlayersCached(unsigned int cache_size) : cache(cache_size) {};
+    AlphaBeta2PlayersCached(
+        TranspositionTable &table,
+        bool use_symmetry = false,
+        Ordering ordering = Ordering(),
+        bool prune_inferior = true
+    ) : table(table), use_symmetry(use_symmetry), ordering(ordering), prune_inferior(prune_inferior) {};
 
     /**
     * This method should be given a HexState object in which it is currently
@@ -45,37 +180,7 @@ public:
     *              force a win from.
     */
     bool one_wins_one_turn(GameState::HexState<bsize> &state) {
-        bool one_wins = false;
-        // First check the transposition table
-        if (this->cache.lookup(state, one_wins)) {
-            return one_wins;
-        }
-        ++this->nodes_expanded;
-
-        // See if we just... actually win right here
-        switch (state.who_won()) {
-            case GameState::PLAYER_ONE:
-                return true;
-            case GameState::PLAYER_TWO:
-                return false;
-            default:
-                break;
-        }
-        // See if we win from any of our succession states
-        GameState::Action backwards;
-        state.default_iter_whose = GameState::PLAYER_ONE;
-        for (const GameState::Action &a : state) {
-            state.succeed(a, backwards);
-            if (this->one_wins_two_turn(state)) {
-                one_wins = true;
-                state.succeed(backwards);
-                break;
-            }
-            state.succeed(backwards);
-        }
-
-        this->cache.insert(state, one_wins);
-        return one_wins;
+        return this->search(state, GameState::PLAYER_ONE).one_wins;
     }
 
     /**
@@ -90,37 +195,381 @@ public:
     *              force a win from.
     */
     bool one_wins_two_turn(GameState::HexState<bsize> &state) {
-        bool one_wins = true;
+        return this->search(state, GameState::PLAYER_TWO).one_wins;
+    }
+
+    /**
+    * Find out who wins a state, unless the search runs out of budget first.
+    * A search that runs out leaves the cache as good as it found it,
+    * so trying the state again later, with more budget, picks up
+    * everything it finished.
+    *
+    * @param state the state to solve, left as it was found.
+    * @param mover the player to move in `state`.
+    * @param budget when to give up.
+    * @return who wins, or PLAYER_NONE if the budget ran out first,
+    *         along with what the search did either way.
+    */
+    Verdict solve_within(GameState::HexState<bsize> &state, GameState::PLAYERS mover, const Budget &budget) {
+        assert(mover == GameState::PLAYER_ONE || mover == GameState::PLAYER_TWO);
+        const auto start = std::chrono::steady_clock::now();
+        const long start_nodes = this->nodes_expanded;
+        this->begin(state, budget);
+
+        const bool one_wins = this->search(state, mover).one_wins;
+        Verdict verdict;
+        if (!this->stopped) {
+            verdict.winner = one_wins ? GameState::PLAYER_ONE : GameState::PLAYER_TWO;
+        }
+        verdict.stats.nodes_expanded = this->nodes_expanded - start_nodes;
+        verdict.stats.elapsed = std::chrono::steady_clock::now() - start;
+        verdict.stats.max_depth = this->max_depth;
+
+        this->end();
+        return verdict;
+    }
+
+    /**
+    * Solve a state completely: who wins, in how few moves, and how.
+    *
+    * Who wins is found out like solve_within does. After that, how few moves
+    * the winner needs comes from a search of its own (see the class), and so does
+    * the line: at each state, the winner plays a move that keeps to the quickest win,
+    * and the loser the move that holds it off the longest. Both searches keep
+    * what they find in the table, so solving a state that is still in it is free.
+    *
+    * If the budget runs out after who wins is known, or the board is too large
+    * for lengths to be kept (see tracks_plies), the result still has the winner
+    * and their winning move, but the line is empty and `plies` is -1.
+    *
+    * @param state the state to solve, left as it was found.
+    * @param mover the player to move in `state`.
+    * @param budget when to give up (by default, never).
+    * @return everything that was found out about `state`,
+    *         with a winner of PLAYER_NONE if the budget ran out first.
+    */
+    SolveResult solve(GameState::HexState<bsize> &state, GameState::PLAYERS mover, const Budget &budget = Budget()) {
+        assert(mover == GameState::PLAYER_ONE || mover == GameState::PLAYER_TWO);
+        SolveResult result;
+        result.winner = state.who_won();
+        if (result.winner != GameState::PLAYER_NONE) {
+            return result;
+        }
+        this->begin(state, budget);
+        const bool one_wins = this->search(state, mover).one_wins;
+        if (!this->stopped) {
+            result.winner = one_wins ? GameState::PLAYER_ONE : GameState::PLAYER_TWO;
+            result.plies = -1;
+            if constexpr (tracks_plies) {
+                this->find_line(state, mover, result);
+            }
+            if (result.winner == mover && result.pv.empty()) {
+                result.move = this->best_move(state);
+            }
+        }
+        this->end();
+        return result;
+    }
+
+    /**
+    * Get the move that settled a state the last time it was solved:
+    * player one's winning move if it is their turn and they win,
+    * or player two's winning answer if it is player two's turn and they win.
+    *
+    * @param state a state which has been solved, and is still in the cache.
+    * @return the move, or nothing if the state isn't in the cache
+    *         or was lost by the player to move.
+    */
+    std::optional<GameState::PackedAction> best_move(const GameState::HexState<bsize> &state) {
+        const std::optional<uint16_t> found = this->table.probe(this->table_key(state));
+        if (!found) {
+            return std::nullopt;
+        }
+        const Entry entry = Entry::unpack(*found);
+        // (the move of a lost state is the loser's)
+        const bool winners_move = entry.one_wins == (entry.best.whose() == GameState::PLAYER_ONE);
+        if (entry.best.whose() == GameState::PLAYER_NONE || !winners_move) {
+            return std::nullopt;
+        }
+        return GameState::PackedAction(this->oriented(state, entry.best.cell()), entry.best.whose());
+    }
+
+private:
+    // the limits of the search on a budget running now, or nullptr if there isn't one
+    const Budget *budget = nullptr;
+    // the value of nodes_expanded, and the time, at which that search has to stop
+    long node_cap = LONG_MAX;
+    std::chrono::steady_clock::time_point deadline;
+    // how many empty cells the state it started from had, and how far below it the search has been
+    int root_empty = 0;
+    int max_depth = 0;
+    // whether it has run out of budget, so that every node above has to give up
+    bool stopped = false;
+
+    // get ready to search `state` on `budget`
+    void begin(const GameState::HexState<bsize> &state, const Budget &budget) {
+        this->table.new_generation();
+        this->budget = &budget;
+        this->node_cap = budget.max_nodes > 0 ? this->nodes_expanded + budget.max_nodes : LONG_MAX;
+        this->deadline = budget.max_time > std::chrono::steady_clock::duration::zero()
+            ? std::chrono::steady_clock::now() + budget.max_time
+            : std::chrono::steady_clock::time_point::max();
+        this->root_empty = state.empty_count();
+        this->max_depth = 0;
+    }
+
+    // and forget about the budget once the search is over
+    void end() {
+        this->budget = nullptr;
+        this->stopped = false;
+    }
+
+    // called before expanding each node: whether the search has to stop there
+    bool out_of_budget(const GameState::HexState<bsize> &state) {
+        if (this->budget == nullptr) {
+            return false;
+        }
+        this->max_depth = std::max(this->max_depth, this->root_empty - state.empty_count());
+        // the clock is slow to read, so only look at it every so often
+        this->stopped = this->stopped
+            || this->nodes_expanded >= this->node_cap
+            || (this->budget->cancel && this->budget->cancel->cancelled())
+            || ((this->nodes_expanded & 1023) == 0 && std::chrono::steady_clock::now() >= this->deadline);
+        return this->stopped;
+    }
+
+    std::optional<bool> in_database(const GameState::HexState<bsize> &state, GameState::PLAYERS mover) const {
+        // a record of a board over 5x5 doesn't fit in a SolvedDatabase file,
+        // so there is never a database for one, and its reader can't even be compiled
+        if constexpr (2 * bsize * bsize + 1 <= 64) {
+            if (this->database != nullptr) {
+                return this->database->one_wins(state, mover);
+            }
+        }
+        return std::nullopt;
+    }
+
+    // how much a state that took every node since `start_nodes` is worth keeping
+    int depth_since(long start_nodes) const {
+        return std::bit_width(static_cast<unsigned long>(this->nodes_expanded - start_nodes));
+    }
+
+    uint64_t table_key(const GameState::HexState<bsize> &state) const {
+        return this->use_symmetry ? state.canonical_hash() : state.hash();
+    }
+
+    // where the Lengths of `winner` for `state` are kept
+    uint64_t lengths_key(const GameState::HexState<bsize> &state, GameState::PLAYERS winner) const {
+        return this->table_key(state) ^ (winner == GameState::PLAYER_ONE ? 0x9e3779b97f4a7c15 : 0xc2b2ae3d27d4eb4f);
+    }
+
+    // a cell of `state` in the orientation of its cache key, and back again
+    int oriented(const GameState::HexState<bsize> &state, int cell) const {
+        const bool rotated = this->use_symmetry && state.canonical_hash() != state.hash();
+        return rotated ? bsize * bsize - 1 - cell : cell;
+    }
+
+    // what one_wins_one_turn and one_wins_two_turn find out about `state`
+    // with `mover` to move (see Entry), or nonsense if the search has stopped
+    Entry search(GameState::HexState<bsize> &state, GameState::PLAYERS mover) {
         // First check the transposition table
-        if (this->cache.lookup(state, one_wins)) {
-            return one_wins;
+        const uint64_t key = this->table_key(state);
+        if (const std::optional<uint16_t> found = this->table.probe(key)) {
+            return Entry::unpack(*found);
         }
-        ++this->nodes_expanded;
+        Entry entry;
+        if (const std::optional<bool> known = this->in_database(state, mover)) {
+            entry.one_wins = *known;
+            return entry;
+        }
+        if (this->out_of_budget(state)) {
+            return entry;
+        }
+        const long start_nodes = this->nodes_expanded++;
 
         // See if we just... actually win right here
         switch (state.who_won()) {
             case GameState::PLAYER_ONE:
-                return true;
+                entry.one_wins = true;
+                return entry;
             case GameState::PLAYER_TWO:
-                return false;
+                return entry;
             default:
                 break;
         }
-        // See if we win from all of our succession states
-        GameState::Action backwards;
-        state.default_iter_whose = GameState::PLAYER_TWO;
-        for (const GameState::Action &a : state) {
-            state.succeed(a, backwards);
-            if (!this->one_wins_one_turn(state)) {
-                one_wins = false;
-                state.succeed(backwards);
+        const bool mover_is_one = mover == GameState::PLAYER_ONE;
+        const GameState::PLAYERS next = mover_is_one ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+        // a stone that connects right away is the quickest win there is,
+        // and far cheaper to find than by trying every move
+        if (const auto now = state.winning_cells(mover); now.any()) {
+            entry.one_wins = mover_is_one;
+            this->settled(state, mover, now.next(), entry);
+            this->table.store(key, entry.pack(), this->depth_since(start_nodes));
+            return entry;
+        }
+        // See if the mover wins from any of their succession states.
+        // every entry in the cache is a final answer, so there is never
+        // a remembered move to try first here (only wins_within has one)
+        entry.one_wins = !mover_is_one;
+        typename Ordering::Moves moves;
+        const int count = this->ordering.order(state, mover, -1, moves);
+        const auto inferior = this->prune_inferior
+            ? InferiorCells<bsize>::inferior_moves(state, mover)
+            : typename GameState::HexState<bsize>::Board();
+        for (int i = 0; i < count; i++) {
+            if (inferior.test(moves[i])) {
+                continue;
+            }
+            state.succeed(GameState::PackedAction(moves[i], mover));
+            const Entry child = this->search(state, next);
+            state.succeed(GameState::PackedAction(moves[i], GameState::PLAYER_NONE));
+            // an unfinished search below says nothing, so nothing is kept from it
+            if (this->stopped) {
+                return entry;
+            }
+            if (child.one_wins == mover_is_one) {
+                entry.one_wins = mover_is_one;
+                this->settled(state, mover, moves[i], entry);
+                break;
+            }
+        }
+
+        this->table.store(key, entry.pack(), this->depth_since(start_nodes));
+        return entry;
+    }
+
+    // `whose` settled `state` by playing `cell`
+    void settled(const GameState::HexState<bsize> &state, GameState::PLAYERS whose, int cell, Entry &entry) {
+        entry.best = GameState::PackedAction(this->oriented(state, cell), whose);
+        this->ordering.cutoff(state, whose, cell);
+    }
+
+    // whether `winner` can win `state`, with `mover` to move, in `plies` moves or fewer
+    // (which is odd if it is the winner's turn and even if it isn't),
+    // or nonsense if the search has stopped
+    bool wins_within(
+        GameState::HexState<bsize> &state,
+        GameState::PLAYERS mover,
+        GameState::PLAYERS winner,
+        int plies
+    ) {
+        const GameState::PLAYERS won = state.who_won();
+        if (won != GameState::PLAYER_NONE) {
+            return won == winner;
+        }
+        if (plies <= 0) {
+            return false;
+        }
+        const uint64_t key = this->lengths_key(state, winner);
+        const int half = plies / 2;
+        Lengths lengths;
+        if (const std::optional<uint16_t> found = this->table.probe(key)) {
+            lengths = Lengths::unpack(*found);
+            if (lengths.at_most <= half) {
+                return true;
+            }
+            if (lengths.at_least > half) {
+                return false;
+            }
+        }
+        if (this->out_of_budget(state)) {
+            return false;
+        }
+        const long start_nodes = this->nodes_expanded++;
+
+        // the winner needs one move that wins in time, and the loser has to have no move that doesn't
+        const bool winners_turn = mover == winner;
+        bool wins = !winners_turn;
+        if (winners_turn && state.winning_cells(mover).any()) {
+            wins = true;
+        } else if (!winners_turn || plies >= 3) {
+            const GameState::PLAYERS next =
+                mover == GameState::PLAYER_ONE ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+            // the move the main search found to win here, if it got here, is a good guess at a quick one
+            const std::optional<GameState::PackedAction> known = winners_turn ? this->best_move(state) : std::nullopt;
+            typename Ordering::Moves moves;
+            const int count = this->ordering.order(state, mover, known ? known->cell() : -1, moves);
+            for (int i = 0; i < count; i++) {
+                state.succeed(GameState::PackedAction(moves[i], mover));
+                const bool child = this->wins_within(state, next, winner, plies - 1);
+                state.succeed(GameState::PackedAction(moves[i], GameState::PLAYER_NONE));
+                if (this->stopped) {
+                    return false;
+                }
+                if (child == winners_turn) {
+                    wins = winners_turn;
+                    this->ordering.cutoff(state, mover, moves[i]);
+                    break;
+                }
+            }
+        }
+
+        if (wins) {
+            lengths.at_most = std::min(lengths.at_most, half);
+        } else {
+            lengths.at_least = std::max(lengths.at_least, half + 1);
+        }
+        this->table.store(key, lengths.pack(), this->depth_since(start_nodes));
+        return wins;
+    }
+
+    // the least amount of moves in which `winner` can win `state`, with `mover` to move,
+    // or -1 if the search stopped before it knew
+    int quickest_win(GameState::HexState<bsize> &state, GameState::PLAYERS mover, GameState::PLAYERS winner) {
+        for (int plies = mover == winner ? 1 : 2; plies <= state.empty_count(); plies += 2) {
+            if (this->wins_within(state, mover, winner, plies)) {
+                return plies;
+            }
+            if (this->stopped) {
                 break;
             }
-            state.succeed(backwards);
+        }
+        return -1;
+    }
+
+    // fill in the `plies` and `pv` of `result`, whose winner is known,
+    // or leave them be if the search stops before they are known
+    void find_line(GameState::HexState<bsize> &state, GameState::PLAYERS mover, SolveResult &result) {
+        const GameState::PLAYERS winner = result.winner;
+        const int plies = this->quickest_win(state, mover, winner);
+        if (plies < 0) {
+            return;
         }
 
-        this->cache.insert(state, one_wins);
-        return one_wins;
+        std::vector<GameState::PackedAction> pv;
+        GameState::HexState<bsize> line = state;
+        GameState::PLAYERS turn = mover;
+        for (int left = plies; left > 0; left--) {
+            const GameState::PLAYERS next =
+                turn == GameState::PLAYER_ONE ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+            // the winner's move has to leave a win in one move less,
+            // and the loser's has to leave no win any quicker than that
+            const auto empty = line.empty_cells();
+            int chosen = -1;
+            for (int c = empty.next(); c < bsize * bsize && chosen < 0; c = empty.next(c + 1)) {
+                line.succeed(GameState::PackedAction(c, turn));
+                const bool keeps = turn == winner
+                    ? this->wins_within(line, next, winner, left - 1)
+                    : !this->wins_within(line, next, winner, left - 3);
+                line.succeed(GameState::PackedAction(c, GameState::PLAYER_NONE));
+                if (this->stopped) {
+                    return;
+                }
+                if (keeps) {
+                    chosen = c;
+                }
+            }
+            assert(chosen >= 0);
+            pv.push_back(GameState::PackedAction(chosen, turn));
+            line.succeed(pv.back());
+            turn = next;
+        }
+
+        result.plies = plies;
+        result.pv = std::move(pv);
+        if (winner == mover) {
+            result.move = result.pv.front();
+        }
     }
 };
 
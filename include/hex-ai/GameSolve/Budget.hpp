@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_BUDGET_HPP
+#define HEX_AI_GAMESOLVE_BUDGET_HPP
+
+#include <chrono>
+
+#include "hex-ai/GameSolve/Cancel.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameSolve {
+
+/**
+ * Budget is how much work a search may do before giving up on a state.
+ * A search stops at whichever limit it reaches first.
+ */
+struct Budget {
+    // the most nodes to expand, or 0 for no limit
+    long max_nodes = 0;
+    // the longest to search for, or zero for no limit
+    std::chrono::steady_clock::duration max_time = std::chrono::steady_clock::duration::zero();
+    // stops the search once raised, or nullptr. It must outlive the search
+    const Cancel *cancel = nullptr;
+};
+
+/**
+ * SearchStats is what a search did, whether or not it finished.
+ */
+struct SearchStats {
+    // how many nodes were expanded (not counting answers found in a cache)
+    long nodes_expanded = 0;
+    // how long the search took
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::duration::zero();
+    // the most moves past the starting state the search got to
+    int max_depth = 0;
+};
+
+/**
+ * Verdict is what a search on a budget found out about a state.
+ */
+struct Verdict {
+    // the player who wins with perfect play,
+    // or PLAYER_NONE if the search ran out of budget before it knew
+    GameState::PLAYERS winner = GameState::PLAYER_NONE;
+    SearchStats stats;
+
+    /**
+     * @return whether the search found out who wins.
+     */
+    bool known() const {
+        return this->winner != GameState::PLAYER_NONE;
+    }
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_BUDGET_HPP
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_CANCEL_HPP
+#define HEX_AI_GAMESOLVE_CANCEL_HPP
+
+#include <atomic>
+
+namespace GameSolve {
+
+/**
+ * Cancel is a flag that any thread can raise to tell a search to give up.
+ *
+ * Flags can hang off of one another: a flag counts as raised if it
+ * or any flag above it is, so raising one flag stops every search
+ * that was handed it or anything below it. A parallel search hands each
+ * node it splits up a flag of its own, below the one it was handed.
+ */
+class Cancel {
+public:
+    /**
+     * @param parent the flag above this one, or nullptr.
+     *               It must outlive this flag.
+     */
+    explicit Cancel(const Cancel *parent = nullptr) : parent(parent) {}
+
+    Cancel(const Cancel &) = delete;
+    Cancel &operator=(const Cancel &) = delete;
+
+    /**
+     * Raise this flag (and so every flag below it).
+     */
+    void cancel() {
+        this->flag.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return true if this flag or any flag above it has been raised.
+     */
+    bool cancelled() const {
+        for (const Cancel *c = this; c; c = c->parent) {
+            if (c->flag.load(std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::atomic<bool> flag = false;
+    const Cancel *parent;
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_CANCEL_HPP
@@ -0,0 +1,379 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_DFPN_HPP
+#define HEX_AI_GAMESOLVE_DFPN_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "hex-ai/GameSolve/Cancel.hpp"
+#include "hex-ai/GameSolve/VCEngine.hpp"
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/Zobrist.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameSolve {
+
+/**
+ * DfpnTable is the transposition table of a DfpnSolver:
+ * a fixed amount of slots, each holding the proof and disproof numbers
+ * of whichever state was stored in it last.
+ *
+ * Several solvers (on several threads) can share one table.
+ * Each slot is two 64 bit words, the numbers and the numbers XORed with
+ * the key, which are read and written without locking. A slot which is
+ * caught halfway through being written by another thread doesn't XOR
+ * back to the key it is looked up with, and so just looks empty.
+ *
+ * A slot is told apart by the whole 64 bit key, not the state itself,
+ * so two states with the same key share their numbers. With random Zobrist
+ * keys that takes about 2^32 states, so the error is possible but unlikely,
+ * as with a TranspositionTable.
+ */
+class DfpnTable {
+public:
+    static constexpr uint32_t INF = UINT32_MAX;
+
+    struct Numbers {
+        uint32_t pn;
+        uint32_t dn;
+    };
+
+    /**
+     * @param size the amount of slots, rounded down to a power of two.
+     *             Each slot takes 16 bytes.
+     */
+    explicit DfpnTable(size_t size) {
+        assert(size > 0);
+        size_t rounded = 1;
+        while (rounded * 2 <= size) {
+            rounded *= 2;
+        }
+        this->slots = std::make_unique<Slot[]>(rounded);
+        this->mask = rounded - 1;
+    }
+
+    /**
+     * @return the numbers stored for `key`, or those of a leaf nobody has looked at.
+     */
+    Numbers lookup(uint64_t key) const {
+        const Slot &slot = this->slots[key & this->mask];
+        const uint64_t numbers = slot.numbers.load(std::memory_order_relaxed);
+        if ((slot.check.load(std::memory_order_relaxed) ^ numbers) != key) {
+            return { 1, 1 };
+        }
+        return { static_cast<uint32_t>(numbers >> 32), static_cast<uint32_t>(numbers) };
+    }
+
+    void store(uint64_t key, Numbers n) {
+        Slot &slot = this->slots[key & this->mask];
+        const uint64_t numbers = uint64_t(n.pn) << 32 | n.dn;
+        slot.numbers.store(numbers, std::memory_order_relaxed);
+        slot.check.store(key ^ numbers, std::memory_order_relaxed);
+    }
+
+    /**
+     * Forget everything in the table.
+     */
+    void clear() {
+        for (size_t i = 0; i <= this->mask; i++) {
+            this->slots[i].numbers.store(0, std::memory_order_relaxed);
+            this->slots[i].check.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> numbers = 0;
+        std::atomic<uint64_t> check = 0;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+};
+
+/**
+ * DfpnSolver decides who wins a game of Hex with depth-first proof-number search.
+ *
+ * Every node has a proof number, the least amount of leaves that would have
+ * to be shown to be won for the player to move to prove they win,
+ * and a disproof number, the same for proving they lose.
+ * The player to move wins if any move wins, so a node's proof number
+ * is the smallest disproof number among its children,
+ * and its disproof number is the sum of their proof numbers.
+ * The search always goes down the child that is cheapest to prove,
+ * and only comes back up once that child's numbers have grown past
+ * thresholds at which some other part of the tree would be cheaper.
+ * Unlike alpha-beta this makes it go deep on the most forcing lines first,
+ * which is most lines in Hex.
+ *
+ * A node in which the player to move can win with one stone is won outright,
+ * and one in which the other player can is searched only through the cell
+ * that stops them (or lost outright, if there are two such cells).
+ * The same goes for virtual connections (see VCEngine): a node in which
+ * the player to move has their edges semi connected is won, and otherwise
+ * only the moves inside every semi connection of the other player are tried.
+ *
+ * Proof and disproof numbers are kept in a DfpnTable,
+ * indexed by the Zobrist key of the state (and whose turn it is).
+ * Every entry holds its whole key, so two states that only share a slot
+ * only cost each other work. Two states with the same 64 bit key, though,
+ * can't be told apart, and share their proven numbers, so the answer
+ * can be wrong, but only with the tiny odds of two states among those
+ * searched having the same key. Children are listed from the middle
+ * of the board outwards, which is how ties between them are broken.
+ */
+template<int bsize>
+class DfpnSolver {
+public:
+    using State = GameState::HexState<bsize>;
+    using Board = typename State::Board;
+    static constexpr int cells = bsize * bsize;
+
+    // tracks how many nodes have been expanded
+    long nodes_expanded = 0;
+
+    /**
+     * @param table_size the amount of entries in the transposition table,
+     *                   rounded down to a power of two.
+     *                   Each entry takes 16 bytes.
+     */
+    explicit DfpnSolver(size_t table_size)
+        : owned(std::make_unique<DfpnTable>(table_size)), table(*this->owned) {}
+
+    /**
+     * @param table a transposition table to share with other solvers,
+     *              which must outlive this one.
+     */
+    explicit DfpnSolver(DfpnTable &table) : table(table) {}
+
+    /**
+     * Same question as AlphaBeta2PlayersCached::one_wins_one_turn.
+     *
+     * @param state a state in which it is player one's turn.
+     * @return true if player one can force a win from `state`.
+     */
+    bool one_wins_one_turn(State &state) {
+        return *this->mover_wins(state, GameState::PLAYER_ONE, nullptr);
+    }
+
+    /**
+     * Same question as AlphaBeta2PlayersCached::one_wins_two_turn.
+     *
+     * @param state a state in which it is player two's turn.
+     * @return true if player one can force a win from `state`.
+     */
+    bool one_wins_two_turn(State &state) {
+        return !*this->mover_wins(state, GameState::PLAYER_TWO, nullptr);
+    }
+
+    /**
+     * Find out whether the player to move wins, unless told to give up first.
+     *
+     * @param state the state to solve, left as it was found.
+     * @param mover the player to move in `state`.
+     * @param cancel stops the search once raised, or nullptr.
+     * @return true if `mover` can force a win, false if they can't,
+     *         or nothing if `cancel` was raised first.
+     */
+    std::optional<bool> mover_wins(State &state, GameState::PLAYERS mover, const Cancel *cancel) {
+        this->cancel = cancel;
+        const uint64_t key = key_of(state, mover);
+        Numbers n = this->table.lookup(key);
+        while (n.pn != 0 && n.dn != 0) {
+            if (this->cancelled()) {
+                return std::nullopt;
+            }
+            n = this->mid(state, key, mover, INF, INF);
+        }
+        return n.pn == 0;
+    }
+
+    /**
+     * Forget everything in the transposition table.
+     */
+    void clear() {
+        this->table.clear();
+    }
+
+    /**
+     * @return the key `state` is stored under in a DfpnTable when it is `mover`'s turn.
+     */
+    static uint64_t key_of(const State &state, GameState::PLAYERS mover) {
+        return state.hash() ^ (mover == GameState::PLAYER_ONE ? one_to_move : two_to_move);
+    }
+
+    /**
+     * @param key the key of a state, when it is `mover`'s turn.
+     * @return the key of the state after `mover` plays at `cell`.
+     */
+    static uint64_t child_key(uint64_t key, int cell, GameState::PLAYERS mover) {
+        return key ^ one_to_move ^ two_to_move ^ GameState::Zobrist<bsize>::key(cell, mover);
+    }
+
+private:
+    using Numbers = DfpnTable::Numbers;
+    static constexpr uint32_t INF = DfpnTable::INF;
+    // mixed into the key of every state depending on whose turn it is
+    static constexpr uint64_t one_to_move = 0x632be59bd9b4e019;
+    static constexpr uint64_t two_to_move = 0x9e3779b97f4a7c15;
+
+    std::unique_ptr<DfpnTable> owned;
+    DfpnTable &table;
+    const Cancel *cancel = nullptr;
+    VCEngine<bsize> vcs;
+
+    bool cancelled() const {
+        return this->cancel && this->cancel->cancelled();
+    }
+
+    // a + b, where INF stays INF and nothing else reaches it
+    static uint32_t add(uint32_t a, uint32_t b) {
+        if (a == INF || b == INF) {
+            return INF;
+        }
+        return static_cast<uint32_t>(std::min<uint64_t>(uint64_t(a) + b, INF - 1));
+    }
+
+    Numbers lookup(uint64_t key) const {
+        return this->table.lookup(key);
+    }
+
+    void store(uint64_t key, Numbers numbers) {
+        this->table.store(key, numbers);
+    }
+
+    /**
+     * Search below `state` until its proof number reaches `th_pn`
+     * or its disproof number reaches `th_dn`.
+     *
+     * @param state the state to search, left as it was found.
+     * @param key key_of(state, mover).
+     * @param mover the player to move in `state`.
+     * @return the proof and disproof numbers of `state` for `mover`,
+     *         which may not have reached either threshold if the search was cancelled.
+     */
+    Numbers mid(State &state, uint64_t key, GameState::PLAYERS mover, uint32_t th_pn, uint32_t th_dn) {
+        Numbers n = this->lookup(key);
+        if (n.pn >= th_pn || n.dn >= th_dn || this->cancelled()) {
+            return n;
+        }
+        ++this->nodes_expanded;
+
+        // whoever just moved may have won, in which case the mover lost
+        const GameState::PLAYERS winner = state.who_won();
+        if (winner != GameState::PLAYER_NONE) {
+            n = winner == mover ? Numbers { 0, INF } : Numbers { INF, 0 };
+            this->store(key, n);
+            return n;
+        }
+
+        const GameState::PLAYERS other =
+            mover == GameState::PLAYER_ONE ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+        // a mover who can win with one stone has won
+        if (state.winning_cells(mover).any()) {
+            n = { 0, INF };
+            this->store(key, n);
+            return n;
+        }
+        // otherwise they have to stop the other player from doing the same,
+        // which they can't if there are two places to stop them in
+        Board moves = state.winning_cells(other);
+        if (moves.count() > 1) {
+            n = { INF, 0 };
+            this->store(key, n);
+            return n;
+        }
+        if (moves.none()) {
+            moves = state.empty_cells();
+        }
+
+        // the same again, for virtual connections instead of single stones
+        this->vcs.compute(state, mover);
+        if (this->vcs.connected() || this->vcs.semi_connected()) {
+            n = { 0, INF };
+            this->store(key, n);
+            return n;
+        }
+        this->vcs.compute(state, other);
+        if (this->vcs.connected()) {
+            n = { INF, 0 };
+            this->store(key, n);
+            return n;
+        }
+        moves &= this->vcs.mustplay();
+        if (moves.none()) {
+            n = { INF, 0 };
+            this->store(key, n);
+            return n;
+        }
+
+        // every child's key follows from this one, without playing the move.
+        // their numbers are only read from the table once, and afterwards
+        // kept here, so children which share a slot don't wipe out each other's work
+        std::array<uint64_t, cells> child_keys;
+        std::array<int16_t, cells> child_cells;
+        std::array<Numbers, cells> child_numbers;
+        int children = 0;
+        for (const int c : GameState::HexGeometry<bsize>::centre_first) {
+            if (!moves.test(c)) {
+                continue;
+            }
+            child_cells[children] = c;
+            child_keys[children] = child_key(key, c, mover);
+            child_numbers[children] = this->lookup(child_keys[children]);
+            children++;
+        }
+
+        while (true) {
+            // the mover wins if any child is lost for the other player
+            n = { INF, 0 };
+            int best = 0;
+            uint32_t best_pn = 0, second_dn = INF;
+            for (int i = 0; i < children; i++) {
+                const Numbers child = child_numbers[i];
+                n.dn = add(n.dn, child.pn);
+                if (child.dn < n.pn) {
+                    second_dn = n.pn;
+                    n.pn = child.dn;
+                    best_pn = child.pn;
+                    best = i;
+                } else if (child.dn < second_dn) {
+                    second_dn = child.dn;
+                }
+            }
+            if (n.pn >= th_pn || n.dn >= th_dn) {
+                break;
+            }
+
+            // search the best child until it is no longer the best
+            const uint32_t child_th_pn = th_dn - n.dn + best_pn;
+            const uint32_t child_th_dn = std::min(th_pn, add(second_dn, 1));
+            state.succeed(GameState::PackedAction(child_cells[best], mover));
+            child_numbers[best] = this->mid(state, child_keys[best], other, child_th_pn, child_th_dn);
+            state.succeed(GameState::PackedAction(child_cells[best], GameState::PLAYER_NONE));
+            if (this->cancelled()) {
+                break;
+            }
+        }
+
+        this->store(key, n);
+        return n;
+    }
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_DFPN_HPP
@@ -7,13 +7,14 @@
 #ifndef HEX_AI_GAMESOLVE_HEXUTIL_HPP
 #define HEX_AI_GAMESOLVE_HEXUTIL_HPP
 
-#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <random>
 #include <utility>
 
 #include "hex-ai/GameState/Action.hpp"
 #include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/StaticActionList.hpp"
 #include "hex-ai/GameState/enums.hpp"
 
 namespace GameSolve {
@@ -38,18 +39,18 @@ int hex_rand_moves(
         || whose_turn == GameState::PLAYER_TWO
     );
     static std::minstd_rand0 rand(0);
-    GameState::Action actions[bsize * bsize];
+    GameState::StaticActionList<bsize> actions;
     state.default_iter_whose = whose_turn;
     GameState::PLAYERS temp =
         state.default_iter_whose == GameState::PLAYER_ONE ? 
         GameState::PLAYER_TWO : GameState::PLAYER_ONE;
     
     while (turns-->0) {
-        size_t count = std::copy(state.begin(), state.end(), &actions[0]) - &actions[0];
-        if (count == 0) {
+        state.get_actions(actions, state.default_iter_whose);
+        if (actions.empty()) {
             return 1;
         }
-        state.succeed(actions[rand() % count]);
+        state.succeed(actions[rand() % actions.size()]);
         std::swap(state.default_iter_whose, temp);
     }
     return 0;
@@ -0,0 +1,256 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_INFERIORCELLS_HPP
+#define HEX_AI_GAMESOLVE_INFERIORCELLS_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameSolve {
+
+/**
+ * InferiorCells finds empty cells that a search never needs to play in,
+ * by looking at the ring of six cells around each one.
+ *
+ * A cell is useless to a player if any way they could win through it
+ * still wins without it. Looking only at its ring, that is the case when
+ * every two ring cells they might use (their own stones and empty cells)
+ * are next to each other or joined by a run of their own stones around
+ * the ring. A cell useless to both players is dead: whoever gets it,
+ * the game comes out the same. Adding stones to a ring never brings
+ * a dead cell back to life.
+ *
+ * From that:
+ *  - dead cells are never worth playing in, since an extra stone anywhere
+ *    else is never worse (Hex is monotone).
+ *  - two empty neighbours a and b are captured by a player if, whichever
+ *    one the other player takes, taking the other kills it. The player
+ *    can treat both as their own, so neither player needs to play there.
+ *  - a move at a is dominated by a move at b, for the player to move,
+ *    if their stone at b would kill a: after b, a stone at a would change
+ *    nothing. A move is only dropped in favour of a move still kept,
+ *    so no two moves can be dropped for each other.
+ *
+ * The ring of a cell off the edge of the board is read one player at a time:
+ * cells past their own edges count as their stones, the rest as the other
+ * player's. Every way a ring can look to a player is worked out for each
+ * board size ahead of time.
+ */
+template<int bsize>
+class InferiorCells {
+public:
+    using State = GameState::HexState<bsize>;
+    using Board = typename State::Board;
+    using Geometry = GameState::HexGeometry<bsize>;
+    static constexpr int cells = bsize * bsize;
+
+    /**
+     * @return the empty cells of `state` that are dead.
+     */
+    static Board dead(const State &state) {
+        const Rings rings(state);
+        Board found;
+        const Board empty = state.empty_cells();
+        for (int c = empty.next(); c < cells; c = empty.next(c + 1)) {
+            if (rings.dead(c)) {
+                found.set(c);
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @param state a state.
+     * @param whose PLAYER_ONE or PLAYER_TWO.
+     * @return the empty cells of `state` in pairs captured by `whose`.
+     */
+    static Board captured(const State &state, GameState::PLAYERS whose) {
+        const Rings rings(state);
+        const Board empty = state.empty_cells();
+        Board found;
+        for (int a = empty.next(); a < cells; a = empty.next(a + 1)) {
+            for (int k = 0; k < 6; k++) {
+                const int b = ring[a][k];
+                if (b > a && empty.test(b) && rings.captured(a, k, whose)) {
+                    found.set(a);
+                    found.set(b);
+                }
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Get the moves a search can leave out, since one of the moves left
+     * is always at least as good. This never leaves out every move.
+     *
+     * @param state a state which nobody has won yet.
+     * @param mover the player to move.
+     * @return the empty cells which are dead, captured by either player
+     *         (a pair at a time, so that pairs don't overlap),
+     *         or dominated by another move that is kept.
+     */
+    static Board inferior_moves(const State &state, GameState::PLAYERS mover) {
+        assert(mover == GameState::PLAYER_ONE || mover == GameState::PLAYER_TWO);
+        const GameState::PLAYERS other =
+            mover == GameState::PLAYER_ONE ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+        const Rings rings(state);
+        const Board empty = state.empty_cells();
+        Board dropped;
+
+        for (int c = empty.next(); c < cells; c = empty.next(c + 1)) {
+            if (rings.dead(c)) {
+                dropped.set(c);
+            }
+        }
+        for (const GameState::PLAYERS whose : { mover, other }) {
+            for (int a = empty.next(); a < cells; a = empty.next(a + 1)) {
+                for (int k = 0; k < 6 && !dropped.test(a); k++) {
+                    const int b = ring[a][k];
+                    if (b >= 0 && empty.test(b) && !dropped.test(b) && rings.captured(a, k, whose)) {
+                        dropped.set(a);
+                        dropped.set(b);
+                    }
+                }
+            }
+        }
+        // everything else is decided, so any move will do
+        if (dropped == empty) {
+            return Board();
+        }
+
+        for (int a = empty.next(); a < cells; a = empty.next(a + 1)) {
+            for (int k = 0; k < 6 && !dropped.test(a); k++) {
+                const int b = ring[a][k];
+                if (b >= 0 && empty.test(b) && !dropped.test(b) && rings.dead_with(a, k, mover)) {
+                    dropped.set(a);
+                }
+            }
+        }
+        return dropped;
+    }
+
+private:
+    // what a ring cell is to the player looking at it
+    enum RingCell { EMPTY = 0, OWN = 1, BLOCKED = 2 };
+
+    static constexpr std::array<int, 7> pow3 { 1, 3, 9, 27, 81, 243, 729 };
+
+    // whether a cell is useless to a player who sees its ring as `code`,
+    // where ring cell k is (code / 3^k) % 3
+    static constexpr std::array<bool, 729> useless = [] {
+        std::array<bool, 729> table {};
+        for (int code = 0; code < 729; code++) {
+            std::array<int, 6> v {};
+            for (int k = 0; k < 6; k++) {
+                v[k] = code / pow3[k] % 3;
+            }
+            // two usable cells are joined if some way around the ring
+            // between them is all own stones (or nothing at all)
+            auto joined_one_way = [&](int i, int j) {
+                for (int k = (i + 1) % 6; k != j; k = (k + 1) % 6) {
+                    if (v[k] != OWN) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            bool result = true;
+            for (int i = 0; i < 6; i++) {
+                for (int j = i + 1; j < 6; j++) {
+                    if (v[i] != BLOCKED && v[j] != BLOCKED
+                        && !joined_one_way(i, j) && !joined_one_way(j, i)) {
+                        result = false;
+                    }
+                }
+            }
+            table[code] = result;
+        }
+        return table;
+    }();
+
+    // the six cells around each cell, in the order of HexGeometry::dx and dy,
+    // or -1 where that is off the board
+    static constexpr std::array<std::array<int, 6>, cells> ring = [] {
+        std::array<std::array<int, 6>, cells> r {};
+        for (int c = 0; c < cells; c++) {
+            for (int k = 0; k < 6; k++) {
+                const int x = c / bsize + Geometry::dx[k], y = c % bsize + Geometry::dy[k];
+                r[c][k] = Geometry::on_board(x, y) ? Geometry::cell_of(x, y) : -1;
+            }
+        }
+        return r;
+    }();
+
+    // the ring code of each cell for each player, counting only what is off the board.
+    // PLAYER_ONE owns what is past y = -1 and y = bsize, PLAYER_TWO past x = -1 and x = bsize
+    static constexpr std::array<std::array<int, cells>, 2> edge_code = [] {
+        std::array<std::array<int, cells>, 2> e {};
+        for (int c = 0; c < cells; c++) {
+            for (int k = 0; k < 6; k++) {
+                const int x = c / bsize + Geometry::dx[k], y = c % bsize + Geometry::dy[k];
+                if (Geometry::on_board(x, y)) {
+                    continue;
+                }
+                const bool past_y = y < 0 || y >= bsize, past_x = x < 0 || x >= bsize;
+                e[0][c] += (past_y ? OWN : BLOCKED) * pow3[k];
+                e[1][c] += (past_x ? OWN : BLOCKED) * pow3[k];
+            }
+        }
+        return e;
+    }();
+
+    // the ring codes of the cells of one state
+    class Rings {
+    public:
+        explicit Rings(const State &state) {
+            for (int p = 0; p < 2; p++) {
+                const Board &own = state.stones_of(p == 0 ? GameState::PLAYER_ONE : GameState::PLAYER_TWO);
+                const Board &theirs = state.stones_of(p == 0 ? GameState::PLAYER_TWO : GameState::PLAYER_ONE);
+                for (int c = 0; c < cells; c++) {
+                    int code = edge_code[p][c];
+                    for (int k = 0; k < 6; k++) {
+                        const int n = ring[c][k];
+                        if (n >= 0) {
+                            code += (own.test(n) ? OWN : theirs.test(n) ? BLOCKED : EMPTY) * pow3[k];
+                        }
+                    }
+                    this->code[p][c] = code;
+                }
+            }
+        }
+
+        bool dead(int c) const {
+            return useless[this->code[0][c]] && useless[this->code[1][c]];
+        }
+
+        // is `c` dead once `whose` takes ring cell k of it (which is empty)
+        bool dead_with(int c, int k, GameState::PLAYERS whose) const {
+            const int mine = whose - 1;
+            return useless[this->code[mine][c] + OWN * pow3[k]]
+                && useless[this->code[1 - mine][c] + BLOCKED * pow3[k]];
+        }
+
+        // are `a` and ring cell k of it captured by `whose`
+        bool captured(int a, int k, GameState::PLAYERS whose) const {
+            const int b = ring[a][k];
+            return this->dead_with(a, k, whose) && this->dead_with(b, (k + 3) % 6, whose);
+        }
+
+    private:
+        std::array<std::array<int, cells>, 2> code;
+    };
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_INFERIORCELLS_HPP
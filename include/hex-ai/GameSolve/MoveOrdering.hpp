@@ -0,0 +1,167 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_MOVEORDERING_HPP
+#define HEX_AI_GAMESOLVE_MOVEORDERING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameSolve {
+
+/**
+ * ORDER_HEURISTICS lists the ways a MoveOrdering can sort moves,
+ * to be ORed together. ORDER_NONE tries moves in raster order.
+ */
+enum ORDER_HEURISTICS : unsigned {
+    ORDER_NONE = 0,
+    ORDER_CENTRE = 1,
+    ORDER_HISTORY = 2,
+    ORDER_KILLERS = 4,
+    ORDER_CACHE_MOVE = 8,
+    ORDER_ALL = 15,
+};
+
+/**
+ * MoveOrdering decides which order a search should try the moves of a state in.
+ * The sooner a search tries a move that settles a node, the fewer moves
+ * it has to try there, so this is most of what makes alpha-beta fast.
+ *
+ * Moves are tried in this order:
+ *  - the move the search's cache remembers as the best one, if any
+ *    (AlphaBeta2PlayersCached has one when it looks for the quickest win
+ *    from a state it already knows the winning move of),
+ *  - the killer moves of the depth, the last two moves that settled
+ *    a node the same amount of moves into the game,
+ *  - the rest, by their history score, which grows every time a move settles
+ *    a node (and more so the higher up in the tree that node is),
+ *  - and among moves that are still tied, the ones nearer the middle
+ *    of the board first.
+ *
+ * A search hands every move that settled a node back to cutoff(),
+ * which is how the killer moves and history scores are learned.
+ * Any class with the same order() and cutoff() can stand in for this one.
+ */
+template<int bsize>
+class MoveOrdering {
+public:
+    using State = GameState::HexState<bsize>;
+    static constexpr int cells = bsize * bsize;
+    using Moves = std::array<int, cells>;
+
+    /**
+     * @param heuristics the ORDER_HEURISTICS to use, ORed together.
+     */
+    explicit MoveOrdering(unsigned heuristics = ORDER_ALL) : heuristics(heuristics) {
+        this->clear();
+    }
+
+    /**
+     * List the empty cells of a state, in the order they should be tried.
+     *
+     * @param state the state to move in.
+     * @param whose the player to move.
+     * @param hint the cell the search's cache remembers as the best move, or -1.
+     * @param moves filled with the cells to try.
+     * @return the amount of cells in `moves`.
+     */
+    int order(const State &state, GameState::PLAYERS whose, int hint, Moves &moves) const {
+        const auto empty = state.empty_cells();
+        const int depth = state.empty_count();
+        std::array<uint64_t, cells> score;
+        int count = 0;
+
+        for (int i = 0; i < cells; i++) {
+            const int c = this->uses(ORDER_CENTRE) ? GameState::HexGeometry<bsize>::centre_first[i] : i;
+            if (!empty.test(c)) {
+                continue;
+            }
+
+            // the tier goes above every history score
+            uint64_t tier = 0;
+            if (this->uses(ORDER_CACHE_MOVE) && c == hint) {
+                tier = 3;
+            } else if (this->uses(ORDER_KILLERS) && c == this->killers[depth][0]) {
+                tier = 2;
+            } else if (this->uses(ORDER_KILLERS) && c == this->killers[depth][1]) {
+                tier = 1;
+            }
+            const uint64_t history = this->uses(ORDER_HISTORY) ? this->history[whose - 1][c] : 0;
+
+            // insertion sort, which keeps the centre first order among ties
+            // (at is never past the end anyway, but GCC can't tell on a 1x1 board)
+            int at = std::min(count++, cells - 1);
+            const uint64_t s = tier << 56 | history;
+            for (; at > 0 && score[at - 1] < s; at--) {
+                score[at] = score[at - 1];
+                moves[at] = moves[at - 1];
+            }
+            score[at] = s;
+            moves[at] = c;
+        }
+        return count;
+    }
+
+    /**
+     * Tell the ordering that a move settled a node.
+     *
+     * @param state the state the move was played from.
+     * @param whose the player who played it.
+     * @param cell the cell played.
+     */
+    void cutoff(const State &state, GameState::PLAYERS whose, int cell) {
+        assert(whose == GameState::PLAYER_ONE || whose == GameState::PLAYER_TWO);
+        const int depth = state.empty_count();
+        std::array<int, 2> &killer = this->killers[depth];
+        if (killer[0] != cell) {
+            killer[1] = killer[0];
+            killer[0] = cell;
+        }
+        uint64_t &h = this->history[whose - 1][cell];
+        h += uint64_t(depth) * depth;
+        // keep every score well below the tiers
+        if (h >= uint64_t(1) << 48) {
+            for (auto &scores : this->history) {
+                for (uint64_t &score : scores) {
+                    score /= 2;
+                }
+            }
+        }
+    }
+
+    /**
+     * Forget every killer move and history score.
+     */
+    void clear() {
+        for (auto &killer : this->killers) {
+            killer = { -1, -1 };
+        }
+        for (auto &scores : this->history) {
+            scores.fill(0);
+        }
+    }
+
+private:
+    unsigned heuristics;
+    // two killer moves for each amount of empty cells
+    std::array<std::array<int, 2>, cells + 1> killers;
+    // a history score for each player and cell
+    std::array<std::array<uint64_t, cells>, 2> history;
+
+    bool uses(ORDER_HEURISTICS h) const {
+        return this->heuristics & h;
+    }
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_MOVEORDERING_HPP
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_PARALLELSOLVER_HPP
+#define HEX_AI_GAMESOLVE_PARALLELSOLVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "hex-ai/GameSolve/Cancel.hpp"
+#include "hex-ai/GameSolve/Dfpn.hpp"
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Util/ThreadPool.hpp"
+
+namespace GameSolve {
+
+/**
+ * ParallelSolver decides who wins a game of Hex using every thread of a ThreadPool.
+ *
+ * Near the root (above `split_depth`) it searches the AND/OR tree itself:
+ * the player to move wins if any of their moves leaves the other player
+ * in a lost position, and every move is searched as its own task,
+ * so the pool's workers spread out over the tree and steal whatever is left
+ * as they run out of work. Each task at `split_depth` is solved by a
+ * DfpnSolver of its own, and every one of those shares a single DfpnTable,
+ * so what one thread proves about a position every other thread can use.
+ *
+ * As soon as one move is found to win, the node it was played from is won,
+ * and its other moves are cancelled. Each node that splits has its own
+ * Cancel flag below its parent's, so cancelling a node also cancels
+ * everything below it, including the DfpnSolvers working there.
+ */
+template<int bsize>
+class ParallelSolver {
+public:
+    using State = GameState::HexState<bsize>;
+    using Board = typename State::Board;
+    static constexpr int cells = bsize * bsize;
+
+    // tracks how many nodes have been expanded, over every thread
+    std::atomic<long> nodes_expanded = 0;
+
+    /**
+     * @param pool the threads to solve with.
+     * @param table_size the amount of entries in the shared DfpnTable,
+     *                   rounded down to a power of two.
+     * @param split_depth how many moves deep to keep splitting moves into tasks.
+     *                    Splitting just the root gives a task per empty cell,
+     *                    which is plenty for a board of 6x6 or more.
+     */
+    ParallelSolver(Util::ThreadPool &pool, size_t table_size, int split_depth = 1)
+        : pool(pool), split_depth(split_depth), table(table_size) {}
+
+    /**
+     * Same question as AlphaBeta2PlayersCached::one_wins_one_turn.
+     *
+     * @param state a state in which it is player one's turn.
+     * @return true if player one can force a win from `state`.
+     */
+    bool one_wins_one_turn(const State &state) {
+        return this->solve(state, GameState::PLAYER_ONE, nullptr, 0) == WIN;
+    }
+
+    /**
+     * Same question as AlphaBeta2PlayersCached::one_wins_two_turn.
+     *
+     * @param state a state in which it is player two's turn.
+     * @return true if player one can force a win from `state`.
+     */
+    bool one_wins_two_turn(const State &state) {
+        return this->solve(state, GameState::PLAYER_TWO, nullptr, 0) == LOSS;
+    }
+
+private:
+    using Dfpn = GameSolve::DfpnSolver<bsize>;
+
+    // how a search ended, for the player to move
+    enum Outcome { LOSS, WIN, CANCELLED };
+
+    Util::ThreadPool &pool;
+    int split_depth;
+    GameSolve::DfpnTable table;
+
+    /**
+     * @param state the state to solve.
+     * @param mover the player to move in `state`.
+     * @param cancel the flag of the closest node above that was split, or nullptr.
+     * @param depth how many moves below the root `state` is.
+     * @return whether `mover` wins, or CANCELLED if the answer is no longer wanted.
+     */
+    Outcome solve(const State &state, GameState::PLAYERS mover, const GameSolve::Cancel *cancel, int depth) {
+        const uint64_t key = Dfpn::key_of(state, mover);
+        const GameSolve::DfpnTable::Numbers known = this->table.lookup(key);
+        if (known.pn == 0 || known.dn == 0) {
+            return known.pn == 0 ? WIN : LOSS;
+        }
+
+        const GameState::PLAYERS other =
+            mover == GameState::PLAYER_ONE ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+        const Board moves = state.empty_cells();
+        // df-pn settles anything already won or about to be straight away
+        const bool quiet = state.who_won() == GameState::PLAYER_NONE
+            && state.winning_cells(mover).none()
+            && state.winning_cells(other).none();
+
+        if (!quiet || depth >= this->split_depth || moves.count() < 2) {
+            State copy = state;
+            Dfpn dfpn(this->table);
+            const std::optional<bool> wins = dfpn.mover_wins(copy, mover, cancel);
+            this->nodes_expanded.fetch_add(dfpn.nodes_expanded, std::memory_order_relaxed);
+            return wins ? (*wins ? WIN : LOSS) : CANCELLED;
+        }
+        this->nodes_expanded.fetch_add(1, std::memory_order_relaxed);
+
+        GameSolve::Cancel mine(cancel);
+        std::atomic<bool> won = false;
+        {
+            Util::ThreadPool::TaskGroup group(this->pool);
+            for (const int c : GameState::HexGeometry<bsize>::centre_first) {
+                if (!moves.test(c)) {
+                    continue;
+                }
+                group.run([&, c] {
+                    State child = state;
+                    child.succeed(GameState::PackedAction(c, mover));
+                    if (this->solve(child, other, &mine, depth + 1) == LOSS) {
+                        won.store(true);
+                        mine.cancel();
+                    }
+                });
+            }
+            group.wait();
+        }
+
+        if (!won.load() && cancel && cancel->cancelled()) {
+            return CANCELLED;
+        }
+        this->table.store(key, won.load()
+            ? GameSolve::DfpnTable::Numbers { 0, GameSolve::DfpnTable::INF }
+            : GameSolve::DfpnTable::Numbers { GameSolve::DfpnTable::INF, 0 });
+        return won.load() ? WIN : LOSS;
+    }
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_PARALLELSOLVER_HPP
@@ -0,0 +1,328 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_RETROGRADE_HPP
+#define HEX_AI_GAMESOLVE_RETROGRADE_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "hex-ai/GameState/FloodFill.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Io/SolvedDatabase0.hpp"
+#include "hex-ai/Util/ThreadPool.hpp"
+
+namespace GameSolve {
+
+/**
+ * RetrogradeSolver works out who wins every state of a normal game
+ * (player one first, then taking turns) on a small board at once,
+ * starting from the full boards and working backwards a ply at a time.
+ *
+ * Every state of a ply (an amount of stones) has an index: the rank
+ * of the set of cells with stones in it, among every set of that many cells,
+ * times the amount of ways to split that many stones between the players,
+ * plus the rank of the way player one's stones sit among them.
+ * Sets are ranked in colexicographic order, which is the order of their
+ * bits as integers, so walking through the indexes of a ply in order
+ * only takes stepping to the next integer with as many bits.
+ *
+ * Each ply is a bit per state, set if the player to move wins it.
+ * A state someone has already won is won by whoever won it,
+ * and any other state by its mover if some move leaves a state of the next ply
+ * that the other player loses. Since a full board is always won by someone,
+ * the last ply needs nothing after it. Every ply is split into chunks of words
+ * which the threads of a ThreadPool sweep through side by side,
+ * each reading only the ply after and writing only its own words.
+ *
+ * A 4x4 board has about 10 million states, a bit over a megabyte of bits.
+ * A 5x5 board has about 1.6 * 10^11, 20 gigabytes, so for 5x5 it is usual
+ * to only work out the plies from some amount of stones on.
+ * From 21 stones on the bits are about 820 megabytes, but the states nobody
+ * has won yet make a file of about 13 gigabytes; from 22 on, about 260 megabytes
+ * and a file of 3 gigabytes.
+ */
+template<int bsize>
+class RetrogradeSolver {
+public:
+    using State = GameState::HexState<bsize>;
+    using Board = typename State::Board;
+    static constexpr int cells = bsize * bsize;
+    static_assert(cells <= 32, "every set of cells must fit in 32 bits");
+
+    /**
+     * @param pool the threads to solve with.
+     * @param min_ply the fewest stones of any state to solve.
+     */
+    RetrogradeSolver(Util::ThreadPool &pool, int min_ply = 0)
+        : pool(pool), min_ply(std::clamp(min_ply, 0, cells)), wins(cells + 1) {}
+
+    /**
+     * Solve every ply from the full board down to `min_ply` stones.
+     */
+    void solve() {
+        for (int ply = cells; ply >= this->min_ply; ply--) {
+            this->solve_ply(ply);
+        }
+    }
+
+    /**
+     * @param state a state.
+     * @param mover the player to move in `state`.
+     * @return whether player one wins `state`, or nothing if it has fewer stones
+     *         than the plies that were solved, or it isn't `mover`'s turn in it
+     *         in a normal game.
+     */
+    std::optional<bool> one_wins(const State &state, GameState::PLAYERS mover) const {
+        const int ply = cells - state.empty_count();
+        if (ply < this->min_ply || this->wins[ply].empty()
+            || Io::SolvedDatabase0<bsize>::to_move(state) != mover) {
+            return std::nullopt;
+        }
+        const uint64_t index = index_of(
+            state.stones_of(GameState::PLAYER_ONE).word(0),
+            state.stones_of(GameState::PLAYER_TWO).word(0)
+        );
+        const bool mover_wins = test(this->wins[ply], index);
+        return mover == GameState::PLAYER_ONE ? mover_wins : !mover_wins;
+    }
+
+    /**
+     * Push every state that was solved, and that nobody has won yet, to `writer`,
+     * which only holds a run of them in memory at a time (see Io::SolvedDatabase0Writer),
+     * but needs as much space for temporary files as the file it writes.
+     */
+    void write(Io::SolvedDatabase0Writer<bsize> &writer) const {
+        for (int ply = this->min_ply; ply <= cells; ply++) {
+            const GameState::PLAYERS mover = ply % 2 ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+            Walk walk(ply, 0);
+            for (uint64_t index = 0; index < ply_size(ply); index++, walk.next()) {
+                const uint64_t ones = walk.ones(), twos = walk.occupied ^ ones;
+                // both orientations are the same state, so only write one of them
+                if (rotated(ones) < ones || (rotated(ones) == ones && rotated(twos) < twos)
+                    || who_won(ones, twos) != GameState::PLAYER_NONE) {
+                    continue;
+                }
+                State state;
+                for (int c = 0; c < cells; c++) {
+                    if (ones >> c & 1) {
+                        state.succeed(GameState::PackedAction(c, GameState::PLAYER_ONE));
+                    } else if (twos >> c & 1) {
+                        state.succeed(GameState::PackedAction(c, GameState::PLAYER_TWO));
+                    }
+                }
+                const bool mover_wins = test(this->wins[ply], index);
+                writer.push(state, mover == GameState::PLAYER_ONE ? mover_wins : !mover_wins);
+            }
+        }
+    }
+
+    /**
+     * @return the amount of states with `ply` stones in a normal game.
+     */
+    static constexpr uint64_t ply_size(int ply) {
+        return choose[cells][ply] * choose[ply][(ply + 1) / 2];
+    }
+
+    /**
+     * @param ones the cells of player one.
+     * @param twos the cells of player two, of which there are as many as
+     *             player one's or one fewer.
+     * @return the index of the state among those of its ply.
+     */
+    static uint64_t index_of(uint64_t ones, uint64_t twos) {
+        const uint64_t occupied = ones | twos;
+        const int ply = std::popcount(occupied);
+        return rank(occupied) * choose[ply][(ply + 1) / 2] + rank(squeeze(ones, occupied));
+    }
+
+    /**
+     * @return n choose k, for 0 <= k <= n <= cells.
+     */
+    static constexpr uint64_t binomial(int n, int k) {
+        return choose[n][k];
+    }
+
+    /**
+     * @param set a set of cells.
+     * @return the colexicographic rank of `set` among the sets with as many members.
+     */
+    static uint64_t rank(uint64_t set) {
+        uint64_t r = 0;
+        for (int j = 1; set; j++, set &= set - 1) {
+            r += choose[std::countr_zero(set)][j];
+        }
+        return r;
+    }
+
+    /**
+     * @param set a set of cells.
+     * @param within another set of cells.
+     * @return the members of `set` that are in `within`,
+     *         numbered by where they are among the members of `within`.
+     */
+    static uint64_t squeeze(uint64_t set, uint64_t within) {
+        uint64_t out = 0;
+        for (int i = 0; within; i++, within &= within - 1) {
+            out |= (set >> std::countr_zero(within) & 1) << i;
+        }
+        return out;
+    }
+
+private:
+    Util::ThreadPool &pool;
+    int min_ply;
+    // wins[ply] holds a bit for each state with `ply` stones, set if its mover wins it
+    std::vector<std::vector<uint64_t>> wins;
+
+    // how many words of a ply each task sweeps
+    static constexpr uint64_t chunk_words = 1 << 10;
+
+    // choose[n][k] is n choose k
+    static constexpr std::array<std::array<uint64_t, cells + 1>, cells + 1> choose = [] {
+        std::array<std::array<uint64_t, cells + 1>, cells + 1> c {};
+        for (int n = 0; n <= cells; n++) {
+            c[n][0] = 1;
+            for (int k = 1; k <= n; k++) {
+                c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+            }
+        }
+        return c;
+    }();
+
+    static bool test(const std::vector<uint64_t> &bits, uint64_t i) {
+        return bits[i >> 6] >> (i & 63) & 1;
+    }
+
+    static GameState::PLAYERS who_won(uint64_t ones, uint64_t twos) {
+        Board b1, b2;
+        b1.set_bits(0, cells, ones);
+        b2.set_bits(0, cells, twos);
+        return GameState::FloodFill<bsize>::who_won(b1, b2);
+    }
+
+    // the cells of a board rotated by 180 degrees
+    static uint64_t rotated(uint64_t cells_of) {
+        Board b;
+        b.set_bits(0, cells, cells_of);
+        return b.reversed().word(0);
+    }
+
+    // the set with colexicographic rank `r` among those with `k` members
+    static uint64_t unrank(uint64_t r, int k) {
+        uint64_t set = 0;
+        for (int p = cells - 1; k > 0; p--) {
+            if (choose[p][k] <= r) {
+                r -= choose[p][k];
+                set |= uint64_t(1) << p;
+                k--;
+            }
+        }
+        return set;
+    }
+
+    // the next integer with as many bits set (Gosper's hack)
+    static uint64_t next_set(uint64_t set) {
+        const uint64_t low = set & -set;
+        const uint64_t up = set + low;
+        return up | (((set ^ up) >> 2) / low);
+    }
+
+    // the inverse of squeeze
+    static uint64_t spread(uint64_t squeezed, uint64_t within) {
+        uint64_t out = 0;
+        for (; within; squeezed >>= 1, within &= within - 1) {
+            out |= (squeezed & 1) << std::countr_zero(within);
+        }
+        return out;
+    }
+
+    /**
+     * Walk steps through the states of a ply in the order of their indexes.
+     */
+    struct Walk {
+        uint64_t occupied;
+        // player one's stones, squeezed into the occupied cells
+        uint64_t split;
+        int ones_count;
+        uint64_t last_split;
+
+        Walk(int ply, uint64_t index) : ones_count((ply + 1) / 2) {
+            const uint64_t splits = choose[ply][this->ones_count];
+            this->occupied = unrank(index / splits, ply);
+            this->split = unrank(index % splits, this->ones_count);
+            this->last_split = ((uint64_t(1) << this->ones_count) - 1) << (ply - this->ones_count);
+        }
+
+        uint64_t ones() const {
+            return spread(this->split, this->occupied);
+        }
+
+        void next() {
+            if (this->split == this->last_split || this->ones_count == 0) {
+                this->split = (uint64_t(1) << this->ones_count) - 1;
+                this->occupied = this->occupied ? next_set(this->occupied) : 0;
+            } else {
+                this->split = next_set(this->split);
+            }
+        }
+    };
+
+    void solve_ply(int ply) {
+        const uint64_t size = ply_size(ply);
+        this->wins[ply].assign((size + 63) / 64, 0);
+        const uint64_t words = this->wins[ply].size();
+        Util::ThreadPool::TaskGroup group(this->pool);
+        for (uint64_t from = 0; from < words; from += chunk_words) {
+            group.run([this, ply, size, from, to = std::min(words, from + chunk_words)] {
+                this->solve_words(ply, size, from, to);
+            });
+        }
+        group.wait();
+    }
+
+    // solve the states of words [from, to) of ply `ply`, which has `size` states
+    void solve_words(int ply, uint64_t size, uint64_t from, uint64_t to) {
+        const GameState::PLAYERS mover = ply % 2 ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+        const std::vector<uint64_t> *after = ply < cells ? &this->wins[ply + 1] : nullptr;
+        std::vector<uint64_t> &bits = this->wins[ply];
+        const uint64_t end = std::min(size, to * 64);
+        Walk walk(ply, from * 64);
+
+        for (uint64_t index = from * 64; index < end; index++, walk.next()) {
+            const uint64_t ones = walk.ones(), twos = walk.occupied ^ ones;
+            bool mover_wins = false;
+            const GameState::PLAYERS won = who_won(ones, twos);
+            if (won != GameState::PLAYER_NONE) {
+                mover_wins = won == mover;
+            } else {
+                assert(after != nullptr);
+                const uint64_t full = (uint64_t(1) << cells) - 1;
+                for (uint64_t empty = full & ~walk.occupied; empty && !mover_wins; empty &= empty - 1) {
+                    const uint64_t cell = empty & -empty;
+                    const uint64_t child = mover == GameState::PLAYER_ONE
+                        ? index_of(ones | cell, twos)
+                        : index_of(ones, twos | cell);
+                    mover_wins = !test(*after, child);
+                }
+            }
+            if (mover_wins) {
+                bits[index >> 6] |= uint64_t(1) << (index & 63);
+            }
+        }
+    }
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_RETROGRADE_HPP
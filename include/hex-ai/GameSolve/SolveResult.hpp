@@ -0,0 +1,40 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_SOLVERESULT_HPP
+#define HEX_AI_GAMESOLVE_SOLVERESULT_HPP
+
+#include <optional>
+#include <vector>
+
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameSolve {
+
+/**
+ * SolveResult is everything a solver found out about a state:
+ * who wins it, how quickly, and how.
+ */
+struct SolveResult {
+    // the player who wins with perfect play,
+    // or PLAYER_NONE if the solver gave up before it knew
+    GameState::PLAYERS winner = GameState::PLAYER_NONE;
+    // a move that wins, if the winner is the player to move.
+    // If they aren't, there is no winning move, and this is empty
+    std::optional<GameState::PackedAction> move;
+    // the moves of a game in which the winner wins as quickly as they can
+    // and the loser holds out as long as they can, up to the winning stone,
+    // or nothing if the solver doesn't know them
+    std::vector<GameState::PackedAction> pv;
+    // the least amount of moves (of both players) the winner needs to win,
+    // or -1 if the solver doesn't know
+    int plies = 0;
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_SOLVERESULT_HPP
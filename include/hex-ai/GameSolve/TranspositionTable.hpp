@@ -0,0 +1,223 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_TRANSPOSITIONTABLE_HPP
+#define HEX_AI_GAMESOLVE_TRANSPOSITIONTABLE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace GameSolve {
+
+/**
+ * TranspositionTable is a fixed size table from 64 bit keys
+ * (like the Zobrist key of a state) to a few bits of data each.
+ *
+ * The table is an array of buckets, each one 64 byte cache line
+ * of 8 entries, and a key can only be in the bucket its low bits pick out,
+ * so a probe costs one cache miss. Every entry is a single 64 bit word:
+ * the top 36 bits of its key (its tag), how old it is, how much work
+ * went into it (its depth), and its data. Since an entry is read and written
+ * in one atomic operation, any amount of threads can probe and store
+ * at once without locking, and a probe never sees half of one store
+ * and half of another.
+ *
+ * A store goes over the entry with the same tag if there is one,
+ * and otherwise over whichever entry of the bucket is worth the least:
+ * an empty one, or else the one with the least depth, where every
+ * generation an entry has gone without being used costs it 4 depth.
+ * A probe that finds an entry from an older generation brings it up to date.
+ *
+ * Two keys with the same bucket and tag can't be told apart, but with 36 bit
+ * tags that takes about 10^10 probes for keys that aren't in the table.
+ */
+class TranspositionTable {
+public:
+    // how many bits of data an entry holds
+    static constexpr int data_bits = 16;
+    // the most depth an entry can have
+    static constexpr int max_depth = 63;
+
+    /**
+     * @param entries the amount of entries, rounded down to a multiple of 8
+     *                that is a power of two (but at least 8).
+     *                Each entry takes 8 bytes.
+     */
+    explicit TranspositionTable(size_t entries) {
+        const size_t buckets = std::bit_floor(std::max<size_t>(entries / bucket_size, 1));
+        std::shared_ptr<Bucket[]> owned = std::make_unique<Bucket[]>(buckets);
+        this->buckets = owned.get();
+        this->storage = std::move(owned);
+        this->mask = buckets - 1;
+    }
+
+    /**
+     * A table whose entries are already in memory somewhere,
+     * like a snapshot of another table (see Io::TranspositionTable0Reader).
+     * The table probes and stores right where they are.
+     *
+     * @param words the entries, as entry() gave them, aligned to 64 bytes.
+     * @param entries how many there are, a multiple of 8 that is a power of two.
+     * @param generation the generation of the table they came from
+     *                   (see current_generation()).
+     * @param storage whatever has to live as long as the table for `words` to.
+     */
+    TranspositionTable(uint64_t *words, size_t entries, uint64_t generation, std::shared_ptr<void> storage)
+        : storage(std::move(storage)), generation(generation) {
+        assert(entries >= bucket_size && std::has_single_bit(entries));
+        assert(reinterpret_cast<uintptr_t>(words) % alignof(Bucket) == 0);
+        assert(generation != 0 && generation <= age_mask);
+        this->buckets = reinterpret_cast<Bucket *>(words);
+        this->mask = entries / bucket_size - 1;
+    }
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    /**
+     * @return the data stored for `key`, or nothing if there isn't any.
+     */
+    std::optional<uint16_t> probe(uint64_t key) {
+        Bucket &bucket = this->buckets[key & this->mask];
+        const uint64_t tag = key >> tag_shift;
+        const uint64_t now = this->generation.load(std::memory_order_relaxed);
+        for (std::atomic<uint64_t> &slot : bucket.entries) {
+            const uint64_t entry = slot.load(std::memory_order_relaxed);
+            if (entry >> tag_shift != tag || entry == 0) {
+                continue;
+            }
+            if ((entry >> age_shift & age_mask) != now) {
+                // if another thread got there first, it only loses an age update
+                uint64_t expected = entry;
+                slot.compare_exchange_strong(
+                    expected,
+                    (entry & ~(age_mask << age_shift)) | now << age_shift,
+                    std::memory_order_relaxed
+                );
+            }
+            return static_cast<uint16_t>(entry & data_mask);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @param key the key to store under.
+     * @param data the data to keep, which must fit in data_bits bits.
+     * @param depth how much work went into `data`, which keeps it from
+     *              being replaced by shallower entries. Clamped to [0, max_depth].
+     */
+    void store(uint64_t key, uint16_t data, int depth) {
+        assert(data <= data_mask);
+        Bucket &bucket = this->buckets[key & this->mask];
+        const uint64_t tag = key >> tag_shift;
+        const uint64_t now = this->generation.load(std::memory_order_relaxed);
+        const uint64_t entry = tag << tag_shift
+            | now << age_shift
+            | uint64_t(std::clamp(depth, 0, max_depth)) << depth_shift
+            | data;
+
+        std::atomic<uint64_t> *victim = &bucket.entries[0];
+        int victim_worth = INT32_MAX;
+        for (std::atomic<uint64_t> &slot : bucket.entries) {
+            const uint64_t old = slot.load(std::memory_order_relaxed);
+            if (old == 0 || old >> tag_shift == tag) {
+                victim = &slot;
+                break;
+            }
+            const int stale = static_cast<int>((now - (old >> age_shift & age_mask)) & age_mask);
+            const int worth = static_cast<int>(old >> depth_shift & depth_mask) - 4 * stale;
+            if (worth < victim_worth) {
+                victim = &slot;
+                victim_worth = worth;
+            }
+        }
+        victim->store(entry, std::memory_order_relaxed);
+    }
+
+    /**
+     * Start a new generation, so that entries not used since
+     * get replaced before those that are.
+     * A search should call this once before it starts.
+     */
+    void new_generation() {
+        uint64_t now = this->generation.load(std::memory_order_relaxed);
+        // an age of 0 is saved for empty entries
+        this->generation.store(now == age_mask ? 1 : now + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Forget everything in the table. This must not race with anything else.
+     */
+    void clear() {
+        for (size_t i = 0; i <= this->mask; i++) {
+            for (std::atomic<uint64_t> &slot : this->buckets[i].entries) {
+                slot.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @return how many entries the table has room for.
+     */
+    size_t capacity() const {
+        return (this->mask + 1) * bucket_size;
+    }
+
+    /**
+     * @param i which entry, less than capacity().
+     * @return entry `i` of the table, as a whole, or 0 if it is empty.
+     *         Stores to it on other threads may or may not be seen.
+     */
+    uint64_t entry(size_t i) const {
+        return this->buckets[i / bucket_size].entries[i % bucket_size].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return the generation the table is in, which is never 0
+     *         and never more than 63.
+     */
+    uint64_t current_generation() const {
+        return this->generation.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr int bucket_size = 8;
+    static constexpr int depth_shift = data_bits;
+    static constexpr int age_shift = depth_shift + 6;
+    static constexpr int tag_shift = age_shift + 6;
+    static constexpr uint64_t data_mask = (uint64_t(1) << data_bits) - 1;
+    static constexpr uint64_t depth_mask = 63;
+    static constexpr uint64_t age_mask = 63;
+    static_assert(tag_shift == 28, "an entry is a 36 bit tag over 28 bits of everything else");
+
+    struct alignas(64) Bucket {
+        std::atomic<uint64_t> entries[bucket_size] {};
+    };
+    static_assert(sizeof(Bucket) == 64, "a bucket is one cache line");
+    static_assert(
+        sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && std::atomic<uint64_t>::is_always_lock_free,
+        "entries in memory are plain words, so that they can be saved and loaded as they are"
+    );
+
+    // what keeps the buckets alive: an array of them, or the memory they were in already
+    std::shared_ptr<void> storage;
+    Bucket *buckets;
+    size_t mask;
+    // the age of entries stored or used now, which is never 0,
+    // so that no entry is ever all zero bits
+    std::atomic<uint64_t> generation = 1;
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_TRANSPOSITIONTABLE_HPP
@@ -0,0 +1,306 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESOLVE_VCENGINE_HPP
+#define HEX_AI_GAMESOLVE_VCENGINE_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "hex-ai/GameState/FloodFill.hpp"
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameSolve {
+
+/**
+ * VCEngine finds the virtual connections of one player in a state of Hex
+ * with H-search (Anshelevich, "A hierarchical approach to computer Hex").
+ *
+ * Two points of the board are fully connected if the player can join them
+ * even when the other player moves first, and semi connected if they can
+ * join them when they move first. Either way the connection comes with
+ * a carrier, the empty cells it needs. Each point is an empty cell,
+ * a group of the player's stones, or one of their two edges.
+ *
+ * H-search starts from the points that are next to each other,
+ * which are fully connected with nothing in their carrier, and then
+ * builds bigger connections out of smaller ones until it runs out:
+ *  - AND: if x and y are both fully connected to z, through carriers that
+ *    don't overlap (or touch x or y), then x and y are fully connected if z
+ *    is the player's, and semi connected (through z) if z is empty.
+ *  - OR: if x and y are semi connected in several ways whose carriers
+ *    have no cell in common, any one cell the other player takes leaves
+ *    one of them whole, so x and y are fully connected.
+ * Bridges and the small edge templates all come out of these two rules.
+ *
+ * H-search only ever finds connections that really hold, but not every one,
+ * so a connection it doesn't find may still be there. Only the
+ * max_full and max_semi smallest carriers are kept between any two points,
+ * and the search stops as soon as the edges are fully connected.
+ */
+template<int bsize>
+class VCEngine {
+public:
+    using State = GameState::HexState<bsize>;
+    using Board = typename State::Board;
+    static constexpr int cells = bsize * bsize;
+    // the amount of carriers kept for each pair of points
+    static constexpr int max_full = 4;
+    static constexpr int max_semi = 8;
+    // the points standing for the player's two edges
+    static constexpr int LOW = 0;
+    static constexpr int HIGH = 1;
+
+    VCEngine() : pairs(max_points * max_points) {}
+
+    /**
+     * Find the virtual connections of a player.
+     *
+     * @param state the state to look at.
+     * @param whose PLAYER_ONE or PLAYER_TWO.
+     */
+    void compute(const State &state, GameState::PLAYERS whose) {
+        assert(whose == GameState::PLAYER_ONE || whose == GameState::PLAYER_TWO);
+        using Fill = GameState::FloodFill<bsize>;
+        const Board mine = state.stones_of(whose);
+        const Board empty = state.empty_cells();
+
+        // the edges, then a point for each group of stones and each empty cell
+        this->points = 2;
+        this->area[LOW] = this->area[HIGH] = Board();
+        this->touches[LOW] = whose == GameState::PLAYER_ONE ? Fill::y_low : Fill::x_low;
+        this->touches[HIGH] = whose == GameState::PLAYER_ONE ? Fill::y_high : Fill::x_high;
+        this->empty_point[LOW] = this->empty_point[HIGH] = false;
+        this->point_at.fill(-1);
+        for (int c = mine.next(); c < cells; c = mine.next(c + 1)) {
+            if (this->point_at[c] != -1) {
+                continue;
+            }
+            Board single;
+            single.set(c);
+            const Board group = Fill::reach(mine, single);
+            this->add_point(group, Fill::grow(group) & ~group, false);
+        }
+        for (int c = empty.next(); c < cells; c = empty.next(c + 1)) {
+            Board single;
+            single.set(c);
+            this->add_point(single, GameState::HexGeometry<bsize>::adjacent[c], true);
+        }
+
+        for (int x = 0; x < this->points; x++) {
+            for (int y = x + 1; y < this->points; y++) {
+                Pair &p = this->pair(x, y);
+                p.fulls = p.semis = 0;
+            }
+        }
+        this->queue.clear();
+        for (int x = 0; x < this->points; x++) {
+            for (int y = x + 1; y < this->points; y++) {
+                if ((this->touches[x] & this->area[y]).any() || (this->touches[y] & this->area[x]).any()) {
+                    this->add_full(x, y, Board());
+                }
+            }
+        }
+
+        // AND every new full connection with every full connection it shares a point with,
+        // until there are none left or the edges are fully connected
+        for (size_t next = 0; next < this->queue.size() && !this->connected(); next++) {
+            const auto [x, y, carrier] = this->queue[next];
+            this->and_rule(x, y, carrier);
+            this->and_rule(y, x, carrier);
+        }
+    }
+
+    /**
+     * @return true if the player's edges are fully connected,
+     *         so that they have won whoever moves next.
+     */
+    bool connected() const {
+        return this->pair(LOW, HIGH).fulls > 0;
+    }
+
+    /**
+     * @return true if the player's edges are semi connected,
+     *         so that they win if they move next.
+     */
+    bool semi_connected() const {
+        return this->pair(LOW, HIGH).semis > 0;
+    }
+
+    /**
+     * Get the cells the other player must move in to stop this one from winning.
+     * Any move outside of them leaves some semi connection between
+     * the edges whole, which the player then completes.
+     *
+     * @return the cells in every semi connection between the edges found,
+     *         or every cell if there aren't any.
+     */
+    Board mustplay() const {
+        Board must = Board::full();
+        const Pair &p = this->pair(LOW, HIGH);
+        for (int i = 0; i < p.semis; i++) {
+            must &= p.semi[i];
+        }
+        return must;
+    }
+
+    /**
+     * @return the point a cell belongs to, or -1 if it is the other player's.
+     */
+    int point_of(int cell) const {
+        return this->point_at[cell];
+    }
+
+    /**
+     * @return the carriers of the full connections found between two points.
+     */
+    std::span<const Board> full(int x, int y) const {
+        const Pair &p = this->pair(x, y);
+        return { p.full.data(), p.fulls };
+    }
+
+    /**
+     * @return the carriers of the semi connections found between two points.
+     */
+    std::span<const Board> semi(int x, int y) const {
+        const Pair &p = this->pair(x, y);
+        return { p.semi.data(), p.semis };
+    }
+
+private:
+    static constexpr int max_points = cells + 2;
+
+    struct Pair {
+        std::array<Board, max_full> full;
+        std::array<Board, max_semi> semi;
+        uint8_t fulls = 0;
+        uint8_t semis = 0;
+    };
+
+    struct Found {
+        int x;
+        int y;
+        Board carrier;
+    };
+
+    int points = 0;
+    // the cells of each point (none for an edge)
+    std::array<Board, max_points> area;
+    // the cells next to each point
+    std::array<Board, max_points> touches;
+    // whether each point is an empty cell, rather than the player's
+    std::array<bool, max_points> empty_point;
+    std::array<int, cells> point_at;
+    // the connections between points x < y, at x * max_points + y
+    std::vector<Pair> pairs;
+    // full connections which haven't been ANDed with the rest yet
+    std::vector<Found> queue;
+
+    void add_point(const Board &area, const Board &touches, bool empty) {
+        const int p = this->points++;
+        this->area[p] = area;
+        this->touches[p] = touches;
+        this->empty_point[p] = empty;
+        for (int c = area.next(); c < cells; c = area.next(c + 1)) {
+            this->point_at[c] = p;
+        }
+    }
+
+    Pair &pair(int x, int y) {
+        return x < y ? this->pairs[x * max_points + y] : this->pairs[y * max_points + x];
+    }
+
+    const Pair &pair(int x, int y) const {
+        return x < y ? this->pairs[x * max_points + y] : this->pairs[y * max_points + x];
+    }
+
+    // is some carrier of `list` inside of `carrier`
+    static bool subsumed(const Board *list, int count, const Board &carrier) {
+        for (int i = 0; i < count; i++) {
+            if ((list[i] & carrier) == list[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // add `carrier` to `list` in place of any carriers it is inside of
+    template<size_t n>
+    static bool insert(std::array<Board, n> &list, uint8_t &count, const Board &carrier) {
+        if (subsumed(list.data(), count, carrier)) {
+            return false;
+        }
+        int kept = 0;
+        for (int i = 0; i < count; i++) {
+            if ((list[i] & carrier) != carrier) {
+                list[kept++] = list[i];
+            }
+        }
+        count = static_cast<uint8_t>(kept);
+        if (count == n) {
+            return false;
+        }
+        list[count++] = carrier;
+        return true;
+    }
+
+    void add_full(int x, int y, const Board &carrier) {
+        Pair &p = this->pair(x, y);
+        if (insert(p.full, p.fulls, carrier)) {
+            this->queue.push_back({ x, y, carrier });
+        }
+    }
+
+    void add_semi(int x, int y, const Board &carrier) {
+        Pair &p = this->pair(x, y);
+        if (subsumed(p.full.data(), p.fulls, carrier) || !insert(p.semi, p.semis, carrier)) {
+            return;
+        }
+        // OR: shrink the common cells of the new semi connection
+        // with the others, until there are none left
+        Board common = carrier, all = carrier;
+        for (int i = 0; i < p.semis - 1; i++) {
+            if ((common & p.semi[i]) != common) {
+                common &= p.semi[i];
+                all |= p.semi[i];
+                if (common.none()) {
+                    this->add_full(x, y, all);
+                    return;
+                }
+            }
+        }
+    }
+
+    // AND the full connection from x to z through `carrier` with those from z
+    void and_rule(int x, int z, const Board &carrier) {
+        for (int y = 0; y < this->points; y++) {
+            if (y == x || y == z) {
+                continue;
+            }
+            const Pair &p = this->pair(z, y);
+            for (int i = 0; i < p.fulls; i++) {
+                const Board &other = p.full[i];
+                if ((carrier & other).any() || (other & this->area[x]).any() || (carrier & this->area[y]).any()) {
+                    continue;
+                }
+                if (this->empty_point[z]) {
+                    this->add_semi(x, y, carrier | other | this->area[z]);
+                } else {
+                    this->add_full(x, y, carrier | other);
+                }
+            }
+        }
+    }
+};
+
+}
+
+#endif // !HEX_AI_GAMESOLVE_VCENGINE_HPP
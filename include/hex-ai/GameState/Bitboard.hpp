@@ -0,0 +1,267 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_BITBOARD_HPP
+#define HEX_AI_GAMESTATE_BITBOARD_HPP
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+namespace GameState {
+
+/**
+ * Bitboard is a fixed size set of bits, one per cell of a board.
+ * Cells are numbered in the same order HexState iterates over them,
+ * so that cell (x, y) of a bsize board is bit x * bsize + y.
+ *
+ * Up to 64 bits this is a single uint64_t, above that it is an array of them.
+ * Bits past `bits` in the last word are always kept at 0, so equality,
+ * counting and emptiness tests can work a whole word at a time.
+ */
+template<int bits, typename std::enable_if<(bits > 0), int>::type = 0>
+class Bitboard {
+public:
+    static constexpr int words = (bits + 63) / 64;
+
+    /**
+     * Get a Bitboard with every one of its `bits` bits set.
+     *
+     * @return a full Bitboard.
+     */
+    static constexpr Bitboard full() {
+        Bitboard b;
+        for (int i = 0; i < words; i++) {
+            b.w[i] = ~uint64_t(0);
+        }
+        b.w[words - 1] &= last_mask;
+        return b;
+    }
+
+    constexpr bool test(int i) const {
+        assert(i >= 0 && i < bits);
+        return (this->w[i >> 6] >> (i & 63)) & 1;
+    }
+
+    constexpr Bitboard &set(int i) {
+        assert(i >= 0 && i < bits);
+        this->w[i >> 6] |= uint64_t(1) << (i & 63);
+        return *this;
+    }
+
+    constexpr Bitboard &reset(int i) {
+        assert(i >= 0 && i < bits);
+        this->w[i >> 6] &= ~(uint64_t(1) << (i & 63));
+        return *this;
+    }
+
+    constexpr bool any() const {
+        for (int i = 0; i < words; i++) {
+            if (this->w[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr bool none() const {
+        return !this->any();
+    }
+
+    /**
+     * @return the amount of bits which are set.
+     */
+    constexpr int count() const {
+        int c = 0;
+        for (int i = 0; i < words; i++) {
+            c += std::popcount(this->w[i]);
+        }
+        return c;
+    }
+
+    /**
+     * Find the lowest set bit at or after bit `from`.
+     *
+     * @param from the first bit to consider.
+     * @return the index of the bit found, or `bits` if there is none.
+     */
+    constexpr int next(int from = 0) const {
+        if (from >= bits) {
+            return bits;
+        }
+        int i = from >> 6;
+        uint64_t word = this->w[i] & (~uint64_t(0) << (from & 63));
+        while (true) {
+            if (word) {
+                return (i << 6) + std::countr_zero(word);
+            }
+            if (++i == words) {
+                return bits;
+            }
+            word = this->w[i];
+        }
+    }
+
+    /**
+     * Read a run of up to 64 bits at once.
+     *
+     * @param from the first bit of the run.
+     * @param n the length of the run, from 1 up to 64.
+     * @return the bits from `from` up to `from + n`, lowest bit first.
+     */
+    constexpr uint64_t bits_at(int from, int n) const {
+        assert(from >= 0 && n > 0 && n <= 64 && from + n <= bits);
+        const int i = from >> 6, shift = from & 63;
+        uint64_t run = this->w[i] >> shift;
+        if (shift + n > 64) {
+            run |= this->w[i + 1] << (64 - shift);
+        }
+        return n == 64 ? run : run & ((uint64_t(1) << n) - 1);
+    }
+
+    /**
+     * Set a run of up to 64 bits at once, leaving the bits already set alone.
+     *
+     * @param from the first bit of the run.
+     * @param n the length of the run, from 1 up to 64.
+     * @param run the bits to set, lowest bit first. Only the lowest n are used.
+     */
+    constexpr Bitboard &set_bits(int from, int n, uint64_t run) {
+        assert(from >= 0 && n > 0 && n <= 64 && from + n <= bits);
+        if (n < 64) {
+            run &= (uint64_t(1) << n) - 1;
+        }
+        const int i = from >> 6, shift = from & 63;
+        this->w[i] |= run << shift;
+        if (shift + n > 64) {
+            this->w[i + 1] |= run >> (64 - shift);
+        }
+        return *this;
+    }
+
+    /**
+     * Raw access to the words making up the board, lowest bits first.
+     */
+    constexpr uint64_t word(int i) const {
+        assert(i >= 0 && i < words);
+        return this->w[i];
+    }
+
+    constexpr bool operator==(const Bitboard &other) const = default;
+
+    constexpr Bitboard &operator&=(const Bitboard &other) {
+        for (int i = 0; i < words; i++) {
+            this->w[i] &= other.w[i];
+        }
+        return *this;
+    }
+
+    constexpr Bitboard &operator|=(const Bitboard &other) {
+        for (int i = 0; i < words; i++) {
+            this->w[i] |= other.w[i];
+        }
+        return *this;
+    }
+
+    constexpr Bitboard &operator^=(const Bitboard &other) {
+        for (int i = 0; i < words; i++) {
+            this->w[i] ^= other.w[i];
+        }
+        return *this;
+    }
+
+    constexpr Bitboard operator&(const Bitboard &other) const {
+        return Bitboard(*this) &= other;
+    }
+
+    constexpr Bitboard operator|(const Bitboard &other) const {
+        return Bitboard(*this) |= other;
+    }
+
+    constexpr Bitboard operator^(const Bitboard &other) const {
+        return Bitboard(*this) ^= other;
+    }
+
+    /**
+     * Complement only flips the `bits` bits that are part of the board.
+     */
+    constexpr Bitboard operator~() const {
+        return Bitboard(*this) ^= full();
+    }
+
+    /**
+     * Move every bit k places up (towards higher indices).
+     * Bits shifted past the end of the board are dropped.
+     *
+     * @param k how far to shift, from 0 up to 63.
+     */
+    constexpr Bitboard operator<<(int k) const {
+        assert(k >= 0 && k < 64);
+        if (k == 0) {
+            return *this;
+        }
+        Bitboard b;
+        for (int i = words - 1; i > 0; i--) {
+            b.w[i] = (this->w[i] << k) | (this->w[i - 1] >> (64 - k));
+        }
+        b.w[0] = this->w[0] << k;
+        b.w[words - 1] &= last_mask;
+        return b;
+    }
+
+    /**
+     * Move every bit k places down (towards lower indices).
+     * Bits shifted below 0 are dropped.
+     *
+     * @param k how far to shift, from 0 up to 63.
+     */
+    constexpr Bitboard operator>>(int k) const {
+        assert(k >= 0 && k < 64);
+        if (k == 0) {
+            return *this;
+        }
+        Bitboard b;
+        for (int i = 0; i < words - 1; i++) {
+            b.w[i] = (this->w[i] >> k) | (this->w[i + 1] << (64 - k));
+        }
+        b.w[words - 1] = this->w[words - 1] >> k;
+        return b;
+    }
+
+    /**
+     * Mirror the board end to end, so that bit i moves to bit bits - 1 - i.
+     * For a square board this rotates it by 180 degrees.
+     */
+    constexpr Bitboard reversed() const {
+        Bitboard b;
+        for (int i = 0; i < words; i++) {
+            b.w[words - 1 - i] = reverse(this->w[i]);
+        }
+        // the reversed words put bit 0 at bit words * 64 - 1
+        return b >> (words * 64 - bits);
+    }
+
+private:
+    static constexpr uint64_t reverse(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555) | ((x & 0x5555555555555555) << 1);
+        x = ((x >> 2) & 0x3333333333333333) | ((x & 0x3333333333333333) << 2);
+        x = ((x >> 4) & 0x0f0f0f0f0f0f0f0f) | ((x & 0x0f0f0f0f0f0f0f0f) << 4);
+        x = ((x >> 8) & 0x00ff00ff00ff00ff) | ((x & 0x00ff00ff00ff00ff) << 8);
+        x = ((x >> 16) & 0x0000ffff0000ffff) | ((x & 0x0000ffff0000ffff) << 16);
+        return (x >> 32) | (x << 32);
+    }
+
+    static constexpr uint64_t last_mask =
+        bits % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (bits % 64)) - 1;
+
+    std::array<uint64_t, words> w {};
+};
+
+}
+
+#endif // !HEX_AI_GAMESTATE_BITBOARD_HPP
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_DYNAMICHEXSTATE_HPP
+#define HEX_AI_GAMESTATE_DYNAMICHEXSTATE_HPP
+
+#include <array>
+#include <cassert>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameState {
+
+// the board sizes that can be chosen at runtime
+constexpr int MIN_DYNAMIC_BSIZE = 1;
+constexpr int MAX_DYNAMIC_BSIZE = 19;
+
+/**
+ * @param bsize a board size, probably read in from somewhere.
+ * @return true if with_bsize (and DynamicHexState) can handle `bsize`.
+ */
+constexpr bool dynamic_bsize(int bsize) {
+    return bsize >= MIN_DYNAMIC_BSIZE && bsize <= MAX_DYNAMIC_BSIZE;
+}
+
+/**
+ * Turn a board size known only at runtime into a compile time one.
+ * `f` is called with a std::integral_constant<int, bsize>,
+ * so that inside of it the size can be used as a template argument:
+ *
+ * GameState::with_bsize(board_size, [&](auto size) {
+ *     GameState::HexState<size> state;
+ *     // everything in here is specialized for this size
+ * });
+ *
+ * The call goes through a table with one entry per size,
+ * so choosing the size costs a single indirect call.
+ * Any loops belong inside of `f`, so they only pay for it once.
+ *
+ * @param bsize the board size, for which dynamic_bsize(bsize) must be true.
+ * @param f the function to call.
+ * @return whatever `f` returns, which must be the same type for every size.
+ */
+template<class F>
+decltype(auto) with_bsize(int bsize, F &&f) {
+    assert(dynamic_bsize(bsize));
+    using R = decltype(f(std::integral_constant<int, MIN_DYNAMIC_BSIZE>{}));
+
+    constexpr auto table = []<int... i>(std::integer_sequence<int, i...>) {
+        return std::array<R (*)(F &), sizeof...(i)> {
+            [](F &g) -> R {
+                return g(std::integral_constant<int, MIN_DYNAMIC_BSIZE + i>{});
+            }...
+        };
+    }(std::make_integer_sequence<int, MAX_DYNAMIC_BSIZE - MIN_DYNAMIC_BSIZE + 1>{});
+
+    return table[bsize - MIN_DYNAMIC_BSIZE](f);
+}
+
+/**
+ * DynamicHexState is a HexState whose board size is chosen at runtime,
+ * for example from the header of a file.
+ * It holds a HexState<bsize> of the right size and forwards to it.
+ *
+ * Every call made through DynamicHexState has to choose the size again,
+ * so anything which does a lot of work on one state should `visit` it
+ * (or use with_bsize) once and do the work on the HexState<bsize> inside.
+ */
+class DynamicHexState {
+public:
+    /**
+     * Make an empty board.
+     *
+     * @param bsize the size of the board, for which dynamic_bsize(bsize) must be true.
+     */
+    explicit DynamicHexState(int bsize) {
+        with_bsize(bsize, [this](auto size) {
+            this->state.emplace<GameState::HexState<size>>();
+        });
+    }
+
+    /**
+     * @return the size of the board.
+     */
+    int bsize() const {
+        return static_cast<int>(this->state.index()) + MIN_DYNAMIC_BSIZE;
+    }
+
+    /**
+     * Call `f` with the HexState<bsize> underneath.
+     *
+     * @param f the function to call, which must accept a HexState of any size.
+     * @return whatever `f` returns, which must be the same type for every size.
+     */
+    template<class F>
+    decltype(auto) visit(F &&f) {
+        return with_bsize(this->bsize(), [&](auto size) -> decltype(auto) {
+            return f(std::get<size - MIN_DYNAMIC_BSIZE>(this->state));
+        });
+    }
+
+    template<class F>
+    decltype(auto) visit(F &&f) const {
+        return with_bsize(this->bsize(), [&](auto size) -> decltype(auto) {
+            return f(std::get<size - MIN_DYNAMIC_BSIZE>(this->state));
+        });
+    }
+
+    GameState::PLAYERS who_won() const {
+        return this->visit([](const auto &s) { return s.who_won(); });
+    }
+
+    DynamicHexState &succeed(const Action &action) {
+        this->visit([&](auto &s) { s.succeed(action); });
+        return *this;
+    }
+
+    void get_actions(std::vector<Action> &buffer, PLAYERS turn = PLAYER_NONE) const {
+        this->visit([&](const auto &s) { s.get_actions(buffer, turn); });
+    }
+
+    void simple_string(std::ostream &out) const {
+        this->visit([&](const auto &s) { s.simple_string(out); });
+    }
+
+    bool verify_board_state() const {
+        return this->visit([](const auto &s) { return s.verify_board_state(); });
+    }
+
+    /**
+     * Serializes the board (but not its size) to a cereal archive,
+     * exactly as the HexState underneath would.
+     */
+    template<class Archive>
+    void save(Archive &archive) const {
+        this->visit([&](const auto &s) { s.save(archive); });
+    }
+
+    /**
+     * Reads in a board of the size this already has from a cereal archive,
+     * exactly as the HexState underneath would.
+     *
+     * @raises cereal::Exception if the gamestate read in had bad values.
+     */
+    template<class Archive>
+    void load(Archive &archive) {
+        this->visit([&](auto &s) { s.load(archive); });
+    }
+
+private:
+    template<int... i>
+    static std::variant<GameState::HexState<MIN_DYNAMIC_BSIZE + i>...>
+        states_of(std::integer_sequence<int, i...>);
+
+    decltype(states_of(
+        std::make_integer_sequence<int, MAX_DYNAMIC_BSIZE - MIN_DYNAMIC_BSIZE + 1>{}
+    )) state;
+};
+
+}
+
+#endif // !HEX_AI_GAMESTATE_DYNAMICHEXSTATE_HPP
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_FLOODFILL_HPP
+#define HEX_AI_GAMESTATE_FLOODFILL_HPP
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "hex-ai/GameState/Bitboard.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameState {
+
+/**
+ * FloodFill finds connections on a board a whole Bitboard at a time.
+ *
+ * Starting from a player's stones on one edge, every round adds all of the
+ * player's stones next to what has been reached so far. Each of the six hex
+ * directions is a single shift of the board (x + 1 is a shift by bsize,
+ * y + 1 a shift by 1, and so on), with the cells that would wrap around from
+ * one side of the board to the other masked away. The fill stops as soon as
+ * it touches the far edge, or once a round adds nothing new.
+ *
+ * Boards of 2 to 4 words are filled inside AVX2 registers when the compiler
+ * targets AVX2 (see the HEX_AI_AVX2 CMake option).
+ */
+template<int bsize>
+class FloodFill {
+    static_assert(bsize > 0 && bsize < 64, "a step in x must fit in one Bitboard shift");
+public:
+    static constexpr int cells = bsize * bsize;
+    using Board = GameState::Bitboard<cells>;
+
+    // the cells along each edge of the board
+    static constexpr Board y_low = [] {
+        Board b;
+        for (int x = 0; x < bsize; x++) {
+            b.set(x * bsize);
+        }
+        return b;
+    }();
+    static constexpr Board y_high = [] {
+        Board b;
+        for (int x = 0; x < bsize; x++) {
+            b.set(x * bsize + bsize - 1);
+        }
+        return b;
+    }();
+    static constexpr Board x_low = [] {
+        Board b;
+        for (int y = 0; y < bsize; y++) {
+            b.set(y);
+        }
+        return b;
+    }();
+    static constexpr Board x_high = [] {
+        Board b;
+        for (int y = 0; y < bsize; y++) {
+            b.set((bsize - 1) * bsize + y);
+        }
+        return b;
+    }();
+
+    /**
+     * Tell which player has won on a board.
+     *
+     * @param ones the stones of PLAYER_ONE, who connects y = 0 to y = bsize - 1.
+     * @param twos the stones of PLAYER_TWO, who connects x = 0 to x = bsize - 1.
+     * @return the player who has won, or PLAYER_NONE.
+     */
+    static GameState::PLAYERS who_won(const Board &ones, const Board &twos) {
+        if (connects(ones, y_low, y_high)) {
+            return PLAYER_ONE;
+        }
+        if (connects(twos, x_low, x_high)) {
+            return PLAYER_TWO;
+        }
+        return PLAYER_NONE;
+    }
+
+    /**
+     * Get every cell in or next to a set of cells.
+     *
+     * @param b the cells to grow.
+     * @return `b` together with all of its hex neighbours.
+     */
+    static constexpr Board grow(const Board &b) {
+        return b | (b << bsize) | (b >> bsize)
+            | (((b << 1) | (b >> (bsize - 1))) & not_y_low)
+            | (((b >> 1) | (b << (bsize - 1))) & not_y_high);
+    }
+
+    /**
+     * Get every stone connected to a set of cells.
+     *
+     * @param stones the stones a connection may go through.
+     * @param from the cells a connection must start in.
+     * @return the stones of `stones` in a group touching `from`.
+     */
+    static constexpr Board reach(const Board &stones, const Board &from) {
+        Board reached = stones & from;
+        while (true) {
+            const Board next = grow(reached) & stones;
+            if (next == reached) {
+                return reached;
+            }
+            reached = next;
+        }
+    }
+
+    /**
+     * Get the empty cells in which a player could win with a single stone.
+     *
+     * @param mine the stones of the player.
+     * @param empty the cells no one has played in.
+     * @param low the edge the player connects from (y_low or x_low).
+     * @param high the edge the player connects to (y_high or x_high).
+     * @return the cells of `empty` that would join `low` to `high`.
+     */
+    static constexpr Board winning_cells(
+        const Board &mine, const Board &empty, const Board &low, const Board &high
+    ) {
+        const Board from_low = grow(reach(mine, low)) | low;
+        const Board from_high = grow(reach(mine, high)) | high;
+        return from_low & from_high & empty;
+    }
+
+    /**
+     * Tell whether a set of stones joins two sets of cells.
+     *
+     * @param stones the stones a connection may go through.
+     * @param from the cells a connection must start in.
+     * @param to the cells a connection must end in.
+     * @return true if some group of `stones` touches both `from` and `to`.
+     */
+    static bool connects(const Board &stones, const Board &from, const Board &to) {
+#if defined(__AVX2__)
+        if constexpr (Board::words >= 2 && Board::words <= 4) {
+            return connects_avx2(stones, from, to);
+        }
+#endif
+        Board reach = stones & from;
+        while (reach.any()) {
+            if ((reach & to).any()) {
+                return true;
+            }
+            const Board next = grow(reach) & stones;
+            if (next == reach) {
+                break;
+            }
+            reach = next;
+        }
+        return false;
+    }
+
+private:
+    // the cells that a step in the +y or -y direction is allowed to land on
+    static constexpr Board not_y_low = ~y_low;
+    static constexpr Board not_y_high = ~y_high;
+
+#if defined(__AVX2__)
+    static __m256i load(const Board &b) {
+        uint64_t w[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < Board::words; i++) {
+            w[i] = b.word(i);
+        }
+        return _mm256_set_epi64x(w[3], w[2], w[1], w[0]);
+    }
+
+    // shift all 256 bits k places up, carrying between the 64 bit lanes
+    template<int k>
+    static __m256i shift_up(__m256i v) {
+        if constexpr (k == 0) {
+            return v;
+        } else {
+            __m256i carry = _mm256_srli_epi64(v, 64 - k);
+            carry = _mm256_permute4x64_epi64(carry, _MM_SHUFFLE(2, 1, 0, 3));
+            carry = _mm256_blend_epi32(carry, _mm256_setzero_si256(), 0x03);
+            return _mm256_or_si256(_mm256_slli_epi64(v, k), carry);
+        }
+    }
+
+    // shift all 256 bits k places down, carrying between the 64 bit lanes
+    template<int k>
+    static __m256i shift_down(__m256i v) {
+        if constexpr (k == 0) {
+            return v;
+        } else {
+            __m256i carry = _mm256_slli_epi64(v, 64 - k);
+            carry = _mm256_permute4x64_epi64(carry, _MM_SHUFFLE(0, 3, 2, 1));
+            carry = _mm256_blend_epi32(carry, _mm256_setzero_si256(), 0xC0);
+            return _mm256_or_si256(_mm256_srli_epi64(v, k), carry);
+        }
+    }
+
+    static bool connects_avx2(const Board &stones, const Board &from, const Board &to) {
+        const __m256i s = load(stones), t = load(to);
+        const __m256i no_low = load(not_y_low), no_high = load(not_y_high);
+        __m256i reach = _mm256_and_si256(s, load(from));
+
+        // anything shifted past the last cell is dropped by ANDing with s
+        while (!_mm256_testz_si256(reach, reach)) {
+            if (!_mm256_testz_si256(reach, t)) {
+                return true;
+            }
+            __m256i next = _mm256_or_si256(
+                reach,
+                _mm256_or_si256(shift_up<bsize>(reach), shift_down<bsize>(reach))
+            );
+            next = _mm256_or_si256(next, _mm256_and_si256(
+                _mm256_or_si256(shift_up<1>(reach), shift_down<bsize - 1>(reach)),
+                no_low
+            ));
+            next = _mm256_or_si256(next, _mm256_and_si256(
+                _mm256_or_si256(shift_down<1>(reach), shift_up<bsize - 1>(reach)),
+                no_high
+            ));
+            next = _mm256_and_si256(next, s);
+
+            const __m256i changed = _mm256_xor_si256(next, reach);
+            if (_mm256_testz_si256(changed, changed)) {
+                break;
+            }
+            reach = next;
+        }
+        return false;
+    }
+#endif
+};
+
+}
+
+#endif // !HEX_AI_GAMESTATE_FLOODFILL_HPP
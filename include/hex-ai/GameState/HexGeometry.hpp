@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_HEXGEOMETRY_HPP
+#define HEX_AI_GAMESTATE_HEXGEOMETRY_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "hex-ai/GameState/Bitboard.hpp"
+
+namespace GameState {
+
+/**
+ * HexGeometry holds tables describing which cells of a bsize board
+ * are next to which, all worked out at compile time.
+ *
+ * Cells are numbered x * bsize + y as everywhere else.
+ * The six neighbours of (x, y) are always listed in the same order:
+ * (x + 1, y), (x, y + 1), (x - 1, y + 1), (x - 1, y), (x, y - 1), (x + 1, y - 1).
+ *
+ * Besides the plain layout there is a padded one, which puts a ring of
+ * extra (sentinel) cells around the board: cell (x, y) is (x + 1, y + 1)
+ * of a (bsize + 2) square. Every real cell then has all six neighbours,
+ * each a fixed offset away, so code working on a padded array
+ * can step to a neighbour without checking the edges of the board first.
+ * The sentinels along y = -1 and y = bsize border PLAYER_ONE's edges,
+ * the ones along x = -1 and x = bsize border PLAYER_TWO's.
+ */
+template<int bsize>
+struct HexGeometry {
+    static constexpr int cells = bsize * bsize;
+    static constexpr int padded_size = bsize + 2;
+    static constexpr int padded_cells = padded_size * padded_size;
+    using Board = GameState::Bitboard<cells>;
+    using Index = int16_t;
+
+    /**
+     * @return true if (x, y) is a cell of the board.
+     */
+    static constexpr bool on_board(int x, int y) {
+        return x >= 0 && x < bsize && y >= 0 && y < bsize;
+    }
+
+    /**
+     * @return the index of cell (x, y).
+     */
+    static constexpr int cell_of(int x, int y) {
+        assert(on_board(x, y));
+        return x * bsize + y;
+    }
+
+    // the x and y coordinates of each cell
+    static constexpr std::array<Index, cells> x_of = [] {
+        std::array<Index, cells> a {};
+        for (int c = 0; c < cells; c++) {
+            a[c] = c / bsize;
+        }
+        return a;
+    }();
+    static constexpr std::array<Index, cells> y_of = [] {
+        std::array<Index, cells> a {};
+        for (int c = 0; c < cells; c++) {
+            a[c] = c % bsize;
+        }
+        return a;
+    }();
+
+    // the steps to each of the six neighbours, in order
+    static constexpr std::array<int, 6> dx { 1, 0, -1, -1, 0, 1 };
+    static constexpr std::array<int, 6> dy { 0, 1, 1, 0, -1, -1 };
+
+    // how far away each of the six neighbours is in the padded layout
+    static constexpr std::array<int, 6> padded_offsets = [] {
+        std::array<int, 6> o {};
+        for (int d = 0; d < 6; d++) {
+            o[d] = dx[d] * padded_size + dy[d];
+        }
+        return o;
+    }();
+
+    /**
+     * @param cell a cell in the plain layout.
+     * @return the same cell in the padded layout.
+     */
+    static constexpr int pad(int cell) {
+        assert(cell >= 0 && cell < cells);
+        return (cell / bsize + 1) * padded_size + cell % bsize + 1;
+    }
+
+    using PaddedBoard = GameState::Bitboard<padded_cells>;
+
+    /**
+     * @param b a Bitboard in the plain layout.
+     * @return the same cells in the padded layout, with every sentinel unset.
+     */
+    static constexpr PaddedBoard pad(const Board &b) {
+        PaddedBoard p;
+        for (int x = 0; x < bsize; x++) {
+            p.set_bits((x + 1) * padded_size + 1, bsize, b.bits_at(x * bsize, bsize));
+        }
+        return p;
+    }
+
+    // the plain cell for each padded cell, or -1 for sentinels
+    static constexpr std::array<Index, padded_cells> unpad = [] {
+        std::array<Index, padded_cells> u {};
+        for (Index &i : u) {
+            i = -1;
+        }
+        for (int c = 0; c < cells; c++) {
+            u[pad(c)] = c;
+        }
+        return u;
+    }();
+
+    // the amount of neighbours each cell has (2, 3, 4 or 6)
+    static constexpr std::array<uint8_t, cells> degree = [] {
+        std::array<uint8_t, cells> deg {};
+        for (int c = 0; c < cells; c++) {
+            for (int d = 0; d < 6; d++) {
+                deg[c] += on_board(c / bsize + dx[d], c % bsize + dy[d]);
+            }
+        }
+        return deg;
+    }();
+
+    // the neighbours of each cell, in order, the first degree[cell] of which are used
+    static constexpr std::array<std::array<Index, 6>, cells> neighbours = [] {
+        std::array<std::array<Index, 6>, cells> n {};
+        for (int c = 0; c < cells; c++) {
+            int found = 0;
+            for (int d = 0; d < 6; d++) {
+                const int x = c / bsize + dx[d], y = c % bsize + dy[d];
+                if (on_board(x, y)) {
+                    n[c][found++] = x * bsize + y;
+                }
+            }
+        }
+        return n;
+    }();
+
+    // every cell, the ones closest to the middle of the board first
+    static constexpr std::array<Index, cells> centre_first = [] {
+        // twice the hex distance of a cell from the centre, to keep it whole
+        auto distance = [](int c) {
+            const int x = 2 * (c / bsize) - (bsize - 1), y = 2 * (c % bsize) - (bsize - 1);
+            const int xy = x + y;
+            return ((x < 0 ? -x : x) + (y < 0 ? -y : y) + (xy < 0 ? -xy : xy)) / 2;
+        };
+        std::array<Index, cells> order {};
+        for (int c = 0; c < cells; c++) {
+            int i = c;
+            for (; i > 0 && distance(order[i - 1]) > distance(c); i--) {
+                order[i] = order[i - 1];
+            }
+            order[i] = c;
+        }
+        return order;
+    }();
+
+    // the neighbours of each cell as a Bitboard
+    static constexpr std::array<Board, cells> adjacent = [] {
+        std::array<Board, cells> a {};
+        for (int c = 0; c < cells; c++) {
+            for (int d = 0; d < degree[c]; d++) {
+                a[c].set(neighbours[c][d]);
+            }
+        }
+        return a;
+    }();
+};
+
+}
+
+#endif // !HEX_AI_GAMESTATE_HEXGEOMETRY_HPP
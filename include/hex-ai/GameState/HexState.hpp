@@ -7,9 +7,11 @@
 #ifndef GAMES_HEX_HEXSTATE_HPP
 #define GAMES_HEX_HEXSTATE_HPP
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <climits>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -25,22 +27,78 @@
 
 #include "hex-ai/GameState/enums.hpp"
 #include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/Bitboard.hpp"
+#include "hex-ai/GameState/FloodFill.hpp"
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/StaticActionList.hpp"
+#include "hex-ai/GameState/WinTracker.hpp"
+#include "hex-ai/GameState/Zobrist.hpp"
 
 namespace GameState {
 
+/**
+ * HexConfig holds the compile time choices about how HexState<bsize>
+ * is implemented. It can be specialized for a board size to change them,
+ * as long as the specialization is seen before HexState<bsize> is used.
+ */
+template<int bsize>
+struct HexConfig {
+    /*
+     * How HexState::who_won finds the winner.
+     * WIN_SEARCH searches the board for a connection on every call.
+     * WIN_UNION_FIND keeps a WinTracker up to date in succeed,
+     * which makes who_won constant time.
+     * WIN_FLOOD fills both players' Bitboards from their edges (see FloodFill),
+     * which keeps succeed cheap and HexState small.
+     *
+     * While the board fits in a single word flooding is about as fast
+     * as reading the tracker, past that the tracker wins.
+     */
+    static constexpr GameState::WIN_CHECK win_check =
+        bsize * bsize <= 64 ? GameState::WIN_FLOOD : GameState::WIN_UNION_FIND;
+};
+
 /**
  * HexState represents a state of a game of Hex.
- * This includes a board of pieces which belongs to two players
+ * This includes a board of pieces which belongs to two players.
+ *
+ * Internally the board is stored as one Bitboard per player,
+ * where cell (x, y) is bit x * bsize + y.
  */
 template<int bsize, typename std::enable_if<(bsize > 0), int>::type = 0>
 class HexState {
-    /*
-     * Give access to std::hash of HexState private members like the board so
-     * that it can be hashed.
+public:
+    // the amount of cells on the board
+    static constexpr int cells = bsize * bsize;
+    using Board = GameState::Bitboard<cells>;
+
+    /**
+     * Position is the stones on a board and nothing else.
+     * Unlike a whole HexState it holds nothing derived from the stones
+     * (like a WinTracker), so it is what large tables of states
+     * (like a solver's cache) should hold on to.
+     * The one exception is the Zobrist key of the stones,
+     * which it carries along so that hashing it is free.
      */
-    friend class std::hash<GameState::HexState<bsize>>;
+    struct Position {
+        // the Zobrist key of stones, first so that comparisons fail fast
+        uint64_t key;
+        // stones[0] holds the cells of PLAYER_ONE, stones[1] those of PLAYER_TWO
+        std::array<Board, 2> stones;
+
+        bool operator==(const Position &other) const = default;
+
+        /**
+         * Hashes a Position by its Zobrist key.
+         */
+        struct Hash {
+            size_t operator()(const Position &p) const {
+                return p.key;
+            }
+        };
+    };
 
-public:
     /**
      * This member gives a default whose for ActionIterators to use in their
      * actions if no player is specified.
@@ -52,8 +110,8 @@ public:
     /**
      * The ActionIterator class allows for iteration over the actions
      * available in a certain HexState.
-     * It is essentially a pointer to an Action object
-     * which implements the increment operator.
+     * Dereferencing it makes the Action it points to, by value,
+     * so a reference taken from it never outlives the iterator.
      *
      * Because ::begin and ::end are defined on HexState using this class,
      * it should be possible to use for each syntax to iterate over moves:
@@ -61,74 +119,79 @@ public:
      * for (const GameState::Action &a : state) {
      *     // do something
      * }
+     *
+     * The iterator takes a copy of the empty cells of the state when it is
+     * made and steps from one set bit to the next, so it does not refer
+     * back to the state at all. Changing the state while iterating over it
+     * does not change which actions the iterator yields.
+     * It is a std::forward_iterator, so it works with std::ranges algorithms.
+     * Since it hands out Actions by value it is only an input iterator
+     * to the older algorithms that go by iterator_category.
      */
     class ActionIterator {
         friend class GameState::HexState<bsize>;
 
     public:
-        using difference_type = long;
+        using difference_type = std::ptrdiff_t;
         using value_type = GameState::Action;
-        using pointer = const GameState::Action *;
-        using reference = const GameState::Action &;
+        using pointer = void;
+        using reference = GameState::Action;
         using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+
+        /**
+         * A default constructed ActionIterator is past the end of any state.
+         */
+        ActionIterator() = default;
+
+        // (the end is at cells, which comes out as (bsize, 0))
+        GameState::Action operator*() const {
+            return {
+                static_cast<unsigned char>(this->cell / bsize),
+                static_cast<unsigned char>(this->cell % bsize),
+                this->whose
+            };
+        }
 
-        const GameState::Action &operator*() const {
-            return this->a;
+        /**
+         * @return the action pointed to as a PackedAction.
+         */
+        GameState::PackedAction packed() const {
+            return { this->cell, this->whose };
         }
 
-        GameState::HexState<bsize>::ActionIterator operator++() {
-            if (this->a.x == bsize) {
-                return *this;
-            }
-            if (++(this->a.y) == bsize) {
-                this->a.y = 0;
-                if (++(this->a.x) == bsize) {
-                    return *this;
-                }
-            }
-            if (state[this->a.x][this->a.y] != PLAYER_NONE) {
-                (*this)++;
-            }
+        ActionIterator &operator++() {
+            this->cell = this->empty.next(this->cell + 1);
             return *this;
         }
 
-        GameState::HexState<bsize>::ActionIterator operator++(int) {
+        ActionIterator operator++(int) {
             ActionIterator copy = *this;
             ++(*this);
             return copy;
         }
 
-        int operator<=>(const ActionIterator &other) const {
-            if (&this->state != &other.state) {
-                return 1;
-            }
-            return ((this->a.x - other.a.x) * bsize + this->a.y - other.a.y);
+        /**
+         * Iterators are ordered by the cell they point to,
+         * with every cell coming before the end.
+         */
+        std::strong_ordering operator<=>(const ActionIterator &other) const {
+            return this->cell <=> other.cell;
         }
 
         bool operator==(const ActionIterator &other) const {
-            return ((*this)<=>other) == 0;
-        }
-
-        bool operator!=(const ActionIterator &other) const {
-            return ((*this)<=>other) != 0;
+            return this->cell == other.cell;
         }
 
     private:
-        const HexState<bsize> &state;
-        GameState::Action a;
-
-        ActionIterator(
-            const HexState<bsize> &state,
-            unsigned char x = 0,
-            unsigned char y = 0
-        ) : state(state) {
-            this->a.whose = state.default_iter_whose;
-            this->a.x = x;
-            this->a.y = y;
-            if (x < bsize && y < bsize && state[x][y] != PLAYER_NONE) {
-                ++(*this);
-            }
-        };
+        // the empty cells of the state, including ones already passed
+        Board empty;
+        // the cell currently pointed to, x * bsize + y, or cells at the end
+        int cell = cells;
+        GameState::PLAYERS whose = PLAYER_NONE;
+
+        ActionIterator(const Board &empty, GameState::PLAYERS whose)
+            : empty(empty), cell(empty.next()), whose(whose) {}
     };
 
     /**
@@ -138,25 +201,24 @@ public:
      */
     ActionIterator begin() const {
         if (this->who_won() != PLAYER_NONE) {
-            return { *this, bsize, 0 };
+            return {};
         }
-        return { *this };
+        return { this->empty_cells(), this->default_iter_whose };
     }
 
     ActionIterator end() const {
-        return { *this, bsize, 0 };
+        return {};
     }
 
     /**
      * Test for equality against another HexState instance.
-     * Two states are considered equal if the contents of their internal
-     * `board` arrays are the same.
+     * Two states are considered equal if both players own the same cells.
      *
      * @param other the state to test equality against.
      * @return      true if the two states are equal, false otherwise.
      */
     bool operator==(const HexState &other) const {
-        return this->board == other.board;
+        return this->key == other.key && this->stones == other.stones;
     }
 
     /**
@@ -169,16 +231,134 @@ public:
         return !(*this==other);
     }
 
+    /**
+     * Read only view of a single x coordinate of a HexState,
+     * so that a state can still be indexed like a 2d array: state[x][y].
+     */
+    class RowView {
+    public:
+        GameState::PLAYERS operator[](size_t y) const {
+            assert(y < bsize);
+            return this->state.at(this->x, y);
+        }
+
+    private:
+        friend class GameState::HexState<bsize>;
+        RowView(const HexState<bsize> &state, size_t x) : state(state), x(x) {}
+
+        const HexState<bsize> &state;
+        size_t x;
+    };
+
     /**
      * Allows caller to access HexState as though it were an array
-     * of player values (as if it were the internal board it holds).
+     * of player values.
      *
      * @param i the x coordinate.
-     * @return the array of values at that x coordinate.
+     * @return a view of the values at that x coordinate.
      */
-    const std::array<PLAYERS, bsize> &operator[](size_t i) const {
+    RowView operator[](size_t i) const {
         assert(i < bsize);
-        return this->board[i];
+        return { *this, i };
+    }
+
+    /**
+     * Get the player occupying a single cell.
+     *
+     * @param x the x coordinate.
+     * @param y the y coordinate.
+     * @return the player at (x, y), or PLAYER_NONE if it is empty.
+     */
+    GameState::PLAYERS at(size_t x, size_t y) const {
+        assert(x < bsize);
+        assert(y < bsize);
+        return this->owner(x * bsize + y);
+    }
+
+    /**
+     * @param p PLAYER_ONE or PLAYER_TWO.
+     * @return the cells owned by player `p`.
+     */
+    const Board &stones_of(GameState::PLAYERS p) const {
+        assert(p == PLAYER_ONE || p == PLAYER_TWO);
+        return this->stones[p - 1];
+    }
+
+    /**
+     * @return the stones on the board, without anything derived from them.
+     */
+    Position position() const {
+        return { this->key, this->stones };
+    }
+
+    /**
+     * Get the Zobrist key of the board (see GameState::Zobrist).
+     * It is kept up to date as stones are placed, so this costs nothing.
+     *
+     * @return a 64 bit hash of the stones on the board.
+     */
+    uint64_t hash() const {
+        return this->key;
+    }
+
+    /**
+     * Get the Position of whichever orientation of the board,
+     * as it is or rotated by 180 degrees, has the smaller Zobrist key.
+     * Both orientations are the same game, and they share a canonical Position.
+     * The key of the rotated board is kept up to date along with the key,
+     * so the board only has to be rotated if it is the one chosen.
+     *
+     * (Transposing the board and swapping colours also gives the same game,
+     * but with the other player to move. Since whose turn it is follows
+     * from the amount of stones on the board, that is never the same
+     * position as far as something like a solver's cache is concerned.)
+     *
+     * @return the canonical Position of this board.
+     */
+    Position canonical() const {
+        if (this->key <= this->rotated_key) {
+            return this->position();
+        }
+        return {
+            this->rotated_key,
+            { this->stones[0].reversed(), this->stones[1].reversed() }
+        };
+    }
+
+    /**
+     * @return the key of canonical(), without making the Position.
+     */
+    uint64_t canonical_hash() const {
+        return std::min(this->key, this->rotated_key);
+    }
+
+    /**
+     * @return the cells owned by neither player.
+     */
+    Board empty_cells() const {
+        return ~(this->stones[0] | this->stones[1]);
+    }
+
+    /**
+     * @return the amount of cells owned by neither player,
+     *         which is kept up to date as stones are placed.
+     */
+    int empty_count() const {
+        return this->empties;
+    }
+
+    /**
+     * Get the cells in which a player would win with a single stone.
+     *
+     * @param whose PLAYER_ONE or PLAYER_TWO.
+     * @return the empty cells that would join `whose`'s two edges.
+     */
+    Board winning_cells(GameState::PLAYERS whose) const {
+        assert(whose == PLAYER_ONE || whose == PLAYER_TWO);
+        using Fill = GameState::FloodFill<bsize>;
+        return whose == PLAYER_ONE
+            ? Fill::winning_cells(this->stones[0], this->empty_cells(), Fill::y_low, Fill::y_high)
+            : Fill::winning_cells(this->stones[1], this->empty_cells(), Fill::x_low, Fill::x_high);
     }
 
     /**
@@ -187,170 +367,52 @@ public:
      * @return an element from the PLAYERS enum detailing which player has won.
      */
     GameState::PLAYERS who_won() const {
-        int xstack[bsize * bsize], ystack[bsize * bsize], stack = 0;
-        PLAYERS mask[bsize][bsize] = { PLAYER_NONE };
-
-        // for all player one positions starting at the bottom
-        for (int start = 0; start < bsize; start++) {
-            if (
-                this->board[start][0] == PLAYER_ONE &&
-                mask[start][0] == PLAYER_NONE
-            ) {
-                xstack[stack] = start;
-                ystack[stack++] = 0;
-
-                while (stack) {
-                    // get next tile and mark as visited
-                    int x = xstack[--stack];
-                    int y = ystack[stack];
-                    mask[x][y] = PLAYER_ONE;
-
-                    if (
-                        x + 1 < bsize &&
-                        mask[x + 1][y] == PLAYER_NONE &&
-                        this->board[x + 1][y] == PLAYER_ONE
-                    ) {
-                        mask[x + 1][y] = PLAYER_ONE;
-                        xstack[stack] = x + 1;
-                        ystack[stack++] = y;
-                    }
-                    if (
-                        y + 1 < bsize &&
-                        mask[x][y + 1] == PLAYER_NONE &&
-                        this->board[x][y + 1] == PLAYER_ONE
-                    ) {
-                        if (y + 1 == bsize - 1) {
-                            return PLAYER_ONE;
-                        } else {
-                            mask[x][y + 1] = PLAYER_ONE;
-                            xstack[stack] = x;
-                            ystack[stack++] = y + 1;
-                        }
-                    }
-                    if (
-                        x - 1 >= 0 &&
-                        y + 1 < bsize &&
-                        mask[x - 1][y + 1] == PLAYER_NONE &&
-                        this->board[x - 1][y + 1] == PLAYER_ONE
-                    ) {
-                        if (y + 1 == bsize - 1) {
-                            return PLAYER_ONE;
-                        } else {
-                            mask[x - 1][y + 1] = PLAYER_ONE;
-                            xstack[stack] = x - 1;
-                            ystack[stack++] = y + 1;
-                        }
-                    }
-                    if (
-                        x - 1 >= 0 &&
-                        mask[x - 1][y] == PLAYER_NONE &&
-                        this->board[x - 1][y] == PLAYER_ONE
-                    ) {
-                        mask[x - 1][y] = PLAYER_ONE;
-                        xstack[stack] = x - 1;
-                        ystack[stack++] = y;
-                    }
-                    if (
-                        y - 1 >= 0 &&
-                        mask[x][y - 1] == PLAYER_NONE &&
-                        this->board[x][y - 1] == PLAYER_ONE
-                    ) {
-                        mask[x][y - 1] = PLAYER_ONE;
-                        xstack[stack] = x;
-                        ystack[stack++] = y - 1;
-                    }
-                    if (
-                        x + 1 < bsize &&
-                        y - 1 >= 0 &&
-                        mask[x + 1][y - 1] == PLAYER_NONE &&
-                        this->board[x + 1][y - 1] == PLAYER_ONE
-                    ) {
-                        mask[x + 1][y - 1] = PLAYER_ONE;
-                        xstack[stack] = x + 1;
-                        ystack[stack++] = y - 1;
-                    }
+        if constexpr (tracks_wins) {
+            return this->tracker.winner();
+        } else if constexpr (HexConfig<bsize>::win_check == GameState::WIN_FLOOD) {
+            return GameState::FloodFill<bsize>::who_won(this->stones[0], this->stones[1]);
+        } else {
+            return this->who_won_search();
+        }
+    }
+
+    /**
+     * Tell which player has won the game by searching the board
+     * for a connection between either player's edges.
+     * This is what who_won does when it has nothing faster to go on.
+     *
+     * @return an element from the PLAYERS enum detailing which player has won.
+     */
+    GameState::PLAYERS who_won_search() const {
+        using Geometry = GameState::HexGeometry<bsize>;
+        // the stones the search has not reached yet, in the padded layout
+        // (so that every neighbour can be tested without going off the board)
+        typename Geometry::PaddedBoard left;
+        int stack[cells], top = 0;
+
+        // player one goes from y = 0 to y = bsize - 1,
+        // player two from x = 0 to x = bsize - 1
+        for (const GameState::PLAYERS whose : { PLAYER_ONE, PLAYER_TWO }) {
+            left = Geometry::pad(this->stones[whose - 1]);
+            for (int i = 0; i < bsize; i++) {
+                const int start = Geometry::pad(whose == PLAYER_ONE ? i * bsize : i);
+                if (left.test(start)) {
+                    left.reset(start);
+                    stack[top++] = start;
                 }
             }
-        }
 
-        // for all player two positions starting at the left
-        for (int start = 0; start < bsize; start++) {
-            if (
-                this->board[0][start] == PLAYER_TWO &&
-                mask[0][start] == PLAYER_NONE
-            ) {
-                xstack[stack] = 0;
-                ystack[stack++] = start;
-
-                while (stack) {
-                    // get next tile and mark as visited
-                    int x = xstack[--stack];
-                    int y = ystack[stack];
-                    mask[x][y] = PLAYER_TWO;
-
-                    if (
-                        x + 1 < bsize &&
-                        mask[x + 1][y] == PLAYER_NONE &&
-                        this->board[x + 1][y] == PLAYER_TWO
-                    ) {
-                        if (x + 1 == bsize - 1) {
-                            return PLAYER_TWO;
-                        } else {
-                            mask[x + 1][y] = PLAYER_TWO;
-                            xstack[stack] = x + 1;
-                            ystack[stack++] = y;
-                        }
-                    }
-                    if (
-                        y + 1 < bsize &&
-                        mask[x][y + 1] == PLAYER_NONE &&
-                        this->board[x][y + 1] == PLAYER_TWO
-                    ) {
-                        mask[x][y + 1] = PLAYER_TWO;
-                        xstack[stack] = x;
-                        ystack[stack++] = y + 1;
-                    }
-                    if (
-                        x - 1 >= 0 &&
-                        y + 1 < bsize &&
-                        mask[x - 1][y + 1] == PLAYER_NONE &&
-                        this->board[x - 1][y + 1] == PLAYER_TWO
-                    ) {
-                        mask[x - 1][y + 1] = PLAYER_TWO;
-                        xstack[stack] = x - 1;
-                        ystack[stack++] = y + 1;
-                    }
-                    if (
-                        x - 1 >= 0 &&
-                        mask[x - 1][y] == PLAYER_NONE &&
-                        this->board[x - 1][y] == PLAYER_TWO
-                    ) {
-                        mask[x - 1][y] = PLAYER_TWO;
-                        xstack[stack] = x - 1;
-                        ystack[stack++] = y;
-                    }
-                    if (
-                        y - 1 >= 0 &&
-                        mask[x][y - 1] == PLAYER_NONE &&
-                        this->board[x][y - 1] == PLAYER_TWO
-                    ) {
-                        mask[x][y - 1] = PLAYER_TWO;
-                        xstack[stack] = x;
-                        ystack[stack++] = y - 1;
-                    }
-                    if (
-                        x + 1 < bsize &&
-                        y - 1 >= 0 &&
-                        mask[x + 1][y - 1] == PLAYER_NONE &&
-                        this->board[x + 1][y - 1] == PLAYER_TWO
-                    ) {
-                        if (x + 1 == bsize - 1) {
-                            return PLAYER_TWO;
-                        } else {
-                            mask[x + 1][y - 1] = PLAYER_TWO;
-                            xstack[stack] = x + 1;
-                            ystack[stack++] = y - 1;
-                        }
+            while (top) {
+                const int p = stack[--top];
+                const int c = Geometry::unpad[p];
+                if ((whose == PLAYER_ONE ? c % bsize : c / bsize) == bsize - 1) {
+                    return whose;
+                }
+                for (const int offset : Geometry::padded_offsets) {
+                    const int n = p + offset;
+                    if (left.test(n)) {
+                        left.reset(n);
+                        stack[top++] = n;
                     }
                 }
             }
@@ -360,18 +422,18 @@ public:
     }
 
     /*
-    * If player P has an action at (x, y), then that tile in the board array should
+    * If player P has an action at (x, y), then that tile on the board should
     * hold their value.
     */
     HexState &succeed(const Action &action) {
         assert(action.x < bsize);
         assert(action.y < bsize);
-        this->board[action.x][action.y] = action.whose;
+        this->place(action.x * bsize + action.y, action.whose);
         return *this;
     }
 
     /*
-    * If player P has an action at (x, y), then that tile in the board array should
+    * If player P has an action at (x, y), then that tile on the board should
     * hold their value.
     * To tell how to undo an action, you just need to know where a player claimed
     * a tile.
@@ -381,8 +443,28 @@ public:
         assert(action.y < bsize);
         baction.x = action.x;
         baction.y = action.y;
-        baction.whose = this->board[action.x][action.y];
-        this->board[action.x][action.y] = action.whose;
+        baction.whose = this->at(action.x, action.y);
+        this->place(action.x * bsize + action.y, action.whose);
+        return *this;
+    }
+
+    /**
+     * Play a PackedAction, which is the same as playing the Action it packs
+     * without working out the index of its cell.
+     */
+    HexState &succeed(const PackedAction &action) {
+        assert(action.cell() < cells);
+        this->place(action.cell(), action.whose());
+        return *this;
+    }
+
+    /**
+     * Play a PackedAction, and put what undoes it in `baction`.
+     */
+    HexState &succeed(const PackedAction &action, PackedAction &baction) {
+        assert(action.cell() < cells);
+        baction = { action.cell(), this->owner(action.cell()) };
+        this->place(action.cell(), action.whose());
         return *this;
     }
 
@@ -396,13 +478,48 @@ public:
             return;
         }
 
-        buffer.reserve(bsize * bsize);
-        for (int x = 0; x < bsize; x++) {
-            for (int y = 0; y < bsize; y++) {
-                if (this->board[x][y] == PLAYER_NONE) {
-                    buffer.emplace_back(x, y, turn);
-                }
-            }
+        // make room for the actions after whatever is in the buffer already,
+        // so that they never have to move partway through
+        const Board empty = this->empty_cells();
+        const size_t at = buffer.size();
+        buffer.resize(at + empty.count());
+        size_t j = at;
+        for (int i = empty.next(); i < cells; i = empty.next(i + 1)) {
+            buffer[j++] = Action(i / bsize, i % bsize, turn);
+        }
+    }
+
+    /**
+     * Same as above, but with PackedActions.
+     */
+    void get_actions(std::vector<PackedAction> &buffer, PLAYERS turn = PLAYER_NONE) const {
+        if (this->who_won() != PLAYER_NONE) {
+            return;
+        }
+
+        // as above, make room once and fill it in
+        const Board empty = this->empty_cells();
+        size_t j = buffer.size();
+        buffer.resize(j + empty.count());
+        for (int i = empty.next(); i < cells; i = empty.next(i + 1)) {
+            buffer[j++] = PackedAction(i, turn);
+        }
+    }
+
+    /**
+     * Same as the first, except that `list` is emptied before it is filled,
+     * since it only has room for one state's worth of actions.
+     * Nothing is allocated.
+     */
+    void get_actions(StaticActionList<bsize> &list, PLAYERS turn = PLAYER_NONE) const {
+        list.clear();
+        if (this->who_won() != PLAYER_NONE) {
+            return;
+        }
+
+        const Board empty = this->empty_cells();
+        for (int i = empty.next(); i < cells; i = empty.next(i + 1)) {
+            list.emplace_back(i / bsize, i % bsize, turn);
         }
     }
 
@@ -414,7 +531,7 @@ public:
     void simple_string(std::ostream &out) const {
         for (int x = 0; x < bsize; x++) {
             for (int y = 0; y < bsize; y++) {
-                switch (this->board[x][y]) {
+                switch (this->at(x, y)) {
                     case PLAYER_ONE:
                         out << '1';
                         break;
@@ -437,30 +554,34 @@ public:
      * @return reference to self
      */
     HexState &flip(GameState::AXIS axis) {
-        switch (axis) {
-            case GameState::HORIZONTAL:
-                for (int x = 0; x < bsize / 2; x++) {
-                    for (int y = 0; y < bsize; y++) {
-                        std::swap(this->board[x][y], this->board[bsize - x - 1][y]);
-                    }
-                }
-                break;
-            case GameState::VERTICAL:
-                for (int x = 0; x < bsize; x++) {
-                    for (int y = 0; y < bsize / 2; y++) {
-                        std::swap(this->board[x][y], this->board[x][bsize - y - 1]);
-                    }
+        for (Board &b : this->stones) {
+            Board flipped;
+            for (int i = b.next(); i < cells; i = b.next(i + 1)) {
+                int x = i / bsize, y = i % bsize;
+                switch (axis) {
+                    case GameState::HORIZONTAL:
+                        x = bsize - x - 1;
+                        break;
+                    case GameState::VERTICAL:
+                        y = bsize - y - 1;
+                        break;
+                    case GameState::BOTH:
+                        x = bsize - x - 1;
+                        y = bsize - y - 1;
+                        break;
                 }
-                break;
-            case GameState::BOTH:
-                return (*this).flip(GameState::VERTICAL).flip(GameState::HORIZONTAL);
+                flipped.set(x * bsize + y);
+            }
+            b = flipped;
         }
+        this->retrack();
         return *this;
     }
 
     /**
-     * verify_board_state makes sure that all values in the internal board
-     * are valid instances of HexState::PLAYERS.
+     * verify_board_state makes sure that every cell of the internal board
+     * holds a valid instance of HexState::PLAYERS,
+     * i.e. that no cell is claimed by both players at once.
      * This probably shouldn't be used a ton,
      * as it should be able to be assumed that the state is always valid.
      * Occasionally (like when reading from files) I imagine it is helpful to
@@ -471,14 +592,7 @@ public:
      *         false if any value is not valid.
      */
     bool verify_board_state() const {
-        for (const std::array<GameState::PLAYERS, bsize> &x_row : this->board) {
-            for (GameState::PLAYERS p : x_row) {
-                if (p < PLAYER_NONE || p > PLAYER_TWO) {
-                    return false;
-                }
-            }
-        }
-        return true;
+        return (this->stones[0] & this->stones[1]).none();
     }
 
     /**
@@ -495,7 +609,7 @@ public:
         // pack in all the board states
         for (int x = 0; x < bsize; x++) {
             for (int y = 0; y < bsize; y++) {
-                pack4 |= (0x03 & this->board[x][y]);
+                pack4 |= (0x03 & this->at(x, y));
                 packed_in++;
 
                 if (packed_in == 4) {
@@ -526,6 +640,7 @@ public:
         uint8_t pack4 = 0;
         uint8_t value;
         int packed_in = 0;
+        this->stones = {};
 
         // get all board states
         for (int x = 0; x < bsize; x++) {
@@ -536,8 +651,14 @@ public:
                 }
 
                 value = (pack4 & 0xc0) >> 6;
-                // okay to cast - we check correctness later
-                this->board[x][y] = static_cast<GameState::PLAYERS>(value);
+                // a value of 3 claims the cell for both players,
+                // which we catch when checking correctness later
+                if (value & PLAYER_ONE) {
+                    this->stones[0].set(x * bsize + y);
+                }
+                if (value & PLAYER_TWO) {
+                    this->stones[1].set(x * bsize + y);
+                }
                 pack4 <<= 2;
                 packed_in--;
             }
@@ -546,15 +667,89 @@ public:
         if (!this->verify_board_state()) {
             throw cereal::Exception("Bad HexState value in cereal import.");
         }
+        this->retrack();
     }
 
 private:
-    std::array<std::array<GameState::PLAYERS, bsize>, bsize> board {};
+    static constexpr bool tracks_wins =
+        HexConfig<bsize>::win_check == GameState::WIN_UNION_FIND;
+    struct NoTracker {};
+
+    // stones[0] holds the cells of PLAYER_ONE, stones[1] those of PLAYER_TWO
+    std::array<Board, 2> stones {};
+    // the Zobrist key of stones, and of stones rotated by 180 degrees
+    uint64_t key = 0;
+    uint64_t rotated_key = 0;
+    // the amount of cells owned by neither player
+    int empties = cells;
+    [[no_unique_address]]
+    std::conditional_t<tracks_wins, GameState::WinTracker<bsize>, NoTracker> tracker;
+
+    GameState::PLAYERS owner(int cell) const {
+        if (this->stones[0].test(cell)) {
+            return PLAYER_ONE;
+        }
+        if (this->stones[1].test(cell)) {
+            return PLAYER_TWO;
+        }
+        return PLAYER_NONE;
+    }
+
+    /**
+     * Set the owner of a single cell, whatever it held before.
+     * Filling an empty cell or emptying the most recently filled one
+     * is cheap for the WinTracker, anything else makes it start over.
+     *
+     * @param cell the index of the cell, x * bsize + y.
+     * @param whose the new owner of the cell.
+     */
+    void place(int cell, GameState::PLAYERS whose) {
+        const GameState::PLAYERS before = this->owner(cell);
+        if (before == whose) {
+            return;
+        }
+        this->stones[0].reset(cell);
+        this->stones[1].reset(cell);
+        this->empties += (before != PLAYER_NONE) - (whose != PLAYER_NONE);
+        if (before != PLAYER_NONE) {
+            this->key ^= GameState::Zobrist<bsize>::key(cell, before);
+            this->rotated_key ^= GameState::Zobrist<bsize>::rotated_key(cell, before);
+        }
+        if (whose != PLAYER_NONE) {
+            this->stones[whose - 1].set(cell);
+            this->key ^= GameState::Zobrist<bsize>::key(cell, whose);
+            this->rotated_key ^= GameState::Zobrist<bsize>::rotated_key(cell, whose);
+        }
+
+        if constexpr (tracks_wins) {
+            // (whose can't also be PLAYER_NONE, but saying so keeps GCC from warning about stones[-1])
+            if (before == PLAYER_NONE && whose != PLAYER_NONE) {
+                this->tracker.add(cell, whose, this->stones[whose - 1]);
+            } else if (whose != PLAYER_NONE || !this->tracker.undo(cell)) {
+                this->tracker.rebuild(this->stones[0], this->stones[1]);
+            }
+        }
+    }
+
+    /**
+     * Bring the Zobrist keys and the WinTracker (if there is one)
+     * back in line with the board after the board was changed wholesale.
+     */
+    void retrack() {
+        this->empties = cells - this->stones[0].count() - this->stones[1].count();
+        this->key = GameState::Zobrist<bsize>::of(this->stones[0], this->stones[1]);
+        this->rotated_key = GameState::Zobrist<bsize>::of(
+            this->stones[0].reversed(), this->stones[1].reversed()
+        );
+        if constexpr (tracks_wins) {
+            this->tracker.rebuild(this->stones[0], this->stones[1]);
+        }
+    }
 };
 
 template<>
 inline GameState::PLAYERS HexState<1>::who_won() const {
-    return this->board[0][0];
+    return this->at(0, 0);
 }
 
 }
@@ -565,16 +760,7 @@ inline GameState::PLAYERS HexState<1>::who_won() const {
 template<int bsize>
 struct std::hash<GameState::HexState<bsize>> {
     size_t operator()(const GameState::HexState<bsize> &state) {
-        size_t result = 0;
-        size_t pow_three = 1;
-        for (int x = 0; x < bsize; x++) {
-            for (int y = 0; y < bsize; y++) {
-                result += ((state.board)[x][y] + 1) * pow_three;
-                pow_three *= 3;
-            }
-        }
-
-        return result;
+        return state.hash();
     }
 };
 
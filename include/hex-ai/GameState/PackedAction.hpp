@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_PACKEDACTION_HPP
+#define HEX_AI_GAMESTATE_PACKEDACTION_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameState {
+
+/**
+ * PackedAction is an Action squeezed into 16 bits:
+ * the index of the cell (x * bsize + y) in the top 14,
+ * and the player claiming it in the bottom 2.
+ *
+ * HexState works in cell indices anyway,
+ * so a PackedAction can be played without working out x * bsize + y,
+ * and it fits boards far larger than the 255 an Action can address.
+ * Since it does not know the size of the board,
+ * turning it into or out of an Action needs the size as a template argument.
+ */
+struct PackedAction {
+    // the largest cell index that fits
+    static constexpr int max_cell = (1 << 14) - 1;
+
+    uint16_t bits = 0;
+
+    constexpr PackedAction() = default;
+
+    /**
+     * @param cell the index of the cell to claim, x * bsize + y.
+     * @param whose the player claiming it (PLAYER_NONE to empty it).
+     */
+    constexpr PackedAction(int cell, GameState::PLAYERS whose)
+        : bits(static_cast<uint16_t>(cell << 2 | whose)) {
+        assert(cell >= 0 && cell <= max_cell);
+    }
+
+    constexpr int cell() const {
+        return this->bits >> 2;
+    }
+
+    constexpr GameState::PLAYERS whose() const {
+        return static_cast<GameState::PLAYERS>(this->bits & 3);
+    }
+
+    /**
+     * @return the same cell claimed by `whose` instead.
+     */
+    constexpr PackedAction with_whose(GameState::PLAYERS whose) const {
+        return { this->cell(), whose };
+    }
+
+    bool operator==(const PackedAction &other) const = default;
+
+    /**
+     * @param action an Action on a bsize board.
+     * @return the same action, packed.
+     */
+    template<int bsize>
+    static constexpr PackedAction from(const GameState::Action &action) {
+        return {
+            GameState::HexGeometry<bsize>::cell_of(action.x, action.y),
+            action.whose
+        };
+    }
+
+    /**
+     * @return this action on a bsize board as an Action.
+     */
+    template<int bsize>
+    GameState::Action unpack() const {
+        using Geometry = GameState::HexGeometry<bsize>;
+        assert(this->cell() < Geometry::cells);
+        return GameState::Action(
+            static_cast<unsigned char>(Geometry::x_of[this->cell()]),
+            static_cast<unsigned char>(Geometry::y_of[this->cell()]),
+            this->whose()
+        );
+    }
+
+    /**
+     * Serializes the action to a cereal archive as its 16 bits.
+     */
+    template<class Archive>
+    void serialize(Archive &archive) {
+        archive(this->bits);
+    }
+};
+
+static_assert(sizeof(PackedAction) == 2);
+
+}
+
+#endif // !HEX_AI_GAMESTATE_PACKEDACTION_HPP
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_STATICACTIONLIST_HPP
+#define HEX_AI_GAMESTATE_STATICACTIONLIST_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameState {
+
+/**
+ * StaticActionList is a list of Actions that lives entirely inside of itself.
+ * It can hold one action for every cell of a bsize board,
+ * which is as many as HexState<bsize>::get_actions could ever give,
+ * so filling one never touches the heap.
+ *
+ * It is meant to be made once (on the stack, say) and refilled:
+ * GameState::StaticActionList<11> actions;
+ * state.get_actions(actions, PLAYER_ONE);
+ * for (const GameState::Action &a : actions) {
+ *     // do something
+ * }
+ */
+template<int bsize>
+class StaticActionList {
+public:
+    static constexpr int cells = bsize * bsize;
+    using value_type = GameState::Action;
+    using size_type = size_t;
+    using iterator = GameState::Action *;
+    using const_iterator = const GameState::Action *;
+
+    /**
+     * @return the amount of actions the list can hold.
+     */
+    static constexpr size_t capacity() {
+        return cells;
+    }
+
+    size_t size() const {
+        return this->count;
+    }
+
+    bool empty() const {
+        return this->count == 0;
+    }
+
+    void clear() {
+        this->count = 0;
+    }
+
+    /**
+     * Add an action to the end of the list, which must not be full.
+     */
+    void push_back(const GameState::Action &action) {
+        assert(this->count < cells);
+        this->actions[this->count++] = action;
+    }
+
+    /**
+     * Add an action to the end of the list, which must not be full.
+     *
+     * @return the action added.
+     */
+    GameState::Action &emplace_back(
+        unsigned char x,
+        unsigned char y,
+        GameState::PLAYERS whose = PLAYER_NONE
+    ) {
+        assert(this->count < cells);
+        return this->actions[this->count++] = GameState::Action(x, y, whose);
+    }
+
+    GameState::Action &operator[](size_t i) {
+        assert(i < this->count);
+        return this->actions[i];
+    }
+
+    const GameState::Action &operator[](size_t i) const {
+        assert(i < this->count);
+        return this->actions[i];
+    }
+
+    GameState::Action *begin() {
+        return this->actions.data();
+    }
+
+    GameState::Action *end() {
+        return this->actions.data() + this->count;
+    }
+
+    const GameState::Action *begin() const {
+        return this->actions.data();
+    }
+
+    const GameState::Action *end() const {
+        return this->actions.data() + this->count;
+    }
+
+private:
+    std::array<GameState::Action, cells> actions;
+    size_t count = 0;
+};
+
+}
+
+#endif // !HEX_AI_GAMESTATE_STATICACTIONLIST_HPP
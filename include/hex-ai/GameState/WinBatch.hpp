@@ -0,0 +1,229 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_WINBATCH_HPP
+#define HEX_AI_GAMESTATE_WINBATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "hex-ai/GameState/FloodFill.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameState {
+
+/**
+ * WinBatch finds the winners of many HexStates at once.
+ *
+ * States are taken `width` at a time and laid out side by side:
+ * word i of every state's Bitboard goes into lane j of a single
+ * SIMD vector, one vector per word. The same shifts FloodFill uses
+ * on one board then grow the connections of all `width` boards at once.
+ * A batch keeps filling until every one of its boards has either
+ * touched its far edge or stopped growing.
+ *
+ * The vectors use the GCC vector extension, so they compile to
+ * whatever SIMD instructions the target has (SSE2 by default,
+ * AVX2 with the HEX_AI_AVX2 CMake option).
+ * That only pays off for boards of more than one word (bigger than 8x8):
+ * smaller boards are checked one at a time, which is faster for them.
+ * A board whose HexConfig tracks wins with WIN_UNION_FIND (the default
+ * past one word) is also checked one at a time, since reading the tracker
+ * is cheaper still. So the batch runs for multi-word boards whose HexConfig
+ * picks WIN_FLOOD or WIN_SEARCH, where on full 11x11 boards it is about
+ * a fifth faster than one FloodFill at a time.
+ */
+template<int bsize>
+class WinBatch {
+public:
+    static constexpr int cells = bsize * bsize;
+    // the amount of states checked side by side
+    static constexpr int width = 4;
+
+    /**
+     * Find the winner of every state in a span.
+     *
+     * @param states the states to check.
+     * @param winners where to put the winners, winners[i] for states[i].
+     *                Must be at least as long as `states`.
+     */
+    static void who_won(
+        std::span<const GameState::HexState<bsize>> states,
+        std::span<GameState::PLAYERS> winners
+    ) {
+        assert(winners.size() >= states.size());
+        // a tracked winner is already as cheap as it gets, and a board of one word
+        // floods faster on its own than in a lane of a vector
+        if constexpr (
+            HexConfig<bsize>::win_check == GameState::WIN_UNION_FIND
+            || GameState::FloodFill<bsize>::Board::words == 1
+        ) {
+            for (size_t i = 0; i < states.size(); i++) {
+                winners[i] = states[i].who_won();
+            }
+            return;
+        }
+
+        for (size_t base = 0; base < states.size(); base += width) {
+            const auto batch = states.subspan(base, std::min<size_t>(width, states.size() - base));
+            const unsigned one_won = connects(
+                load(batch, PLAYER_ONE), Fill::y_low, Fill::y_high
+            );
+            // player two can only have won where player one has not
+            const unsigned two_won = connects(
+                load(batch, PLAYER_TWO, one_won), Fill::x_low, Fill::x_high
+            );
+            for (size_t j = 0; j < batch.size(); j++) {
+                winners[base + j] =
+                    (one_won >> j) & 1 ? PLAYER_ONE :
+                    (two_won >> j) & 1 ? PLAYER_TWO : PLAYER_NONE;
+            }
+        }
+    }
+
+private:
+    using Fill = GameState::FloodFill<bsize>;
+    using Board = typename Fill::Board;
+    static constexpr int words = Board::words;
+
+    // one word from each of `width` boards
+    typedef uint64_t Lane __attribute__((vector_size(width * sizeof(uint64_t))));
+    // `width` whole boards
+    using Wide = std::array<Lane, words>;
+
+    // lay out the stones of `whose` from each state, except those in `skip`
+    static Wide load(
+        std::span<const GameState::HexState<bsize>> batch,
+        GameState::PLAYERS whose,
+        unsigned skip = 0
+    ) {
+        Wide b {};
+        for (size_t j = 0; j < batch.size(); j++) {
+            if ((skip >> j) & 1) {
+                continue;
+            }
+            for (int w = 0; w < words; w++) {
+                b[w][j] = batch[j].stones_of(whose).word(w);
+            }
+        }
+        return b;
+    }
+
+    // the same Board in every lane
+    static Wide broadcast(const Board &board) {
+        Wide b;
+        for (int w = 0; w < words; w++) {
+            b[w] = Lane {} + board.word(w);
+        }
+        return b;
+    }
+
+    template<int k>
+    static Wide shift_up(const Wide &b) {
+        if constexpr (k == 0) {
+            return b;
+        } else {
+            Wide s;
+            for (int w = words - 1; w > 0; w--) {
+                s[w] = (b[w] << k) | (b[w - 1] >> (64 - k));
+            }
+            s[0] = b[0] << k;
+            return s;
+        }
+    }
+
+    template<int k>
+    static Wide shift_down(const Wide &b) {
+        if constexpr (k == 0) {
+            return b;
+        } else {
+            Wide s;
+            for (int w = 0; w < words - 1; w++) {
+                s[w] = (b[w] >> k) | (b[w + 1] << (64 - k));
+            }
+            s[words - 1] = b[words - 1] >> k;
+            return s;
+        }
+    }
+
+    /**
+     * @return a mask with bit j set if, in lane j,
+     *         some group of `stones` touches both `from` and `to`.
+     */
+    static unsigned connects(const Wide &stones, const Board &from, const Board &to) {
+        const Wide to_mask = broadcast(to);
+        const Wide not_y_low = broadcast(~Fill::y_low);
+        const Wide not_y_high = broadcast(~Fill::y_high);
+
+        const Wide start = broadcast(from);
+        bool empty = true;
+        for (int w = 0; w < words; w++) {
+            for (int j = 0; j < width; j++) {
+                empty &= stones[w][j] == 0;
+            }
+        }
+        if (empty) {
+            return 0;
+        }
+
+        Wide reach;
+        for (int w = 0; w < words; w++) {
+            reach[w] = stones[w] & start[w];
+        }
+        while (true) {
+            const Wide up_x = shift_up<bsize>(reach), down_x = shift_down<bsize>(reach);
+            const Wide up_y = shift_up<1>(reach), down_y = shift_down<1>(reach);
+            const Wide up_x_down_y = shift_up<bsize - 1>(reach);
+            const Wide down_x_up_y = shift_down<bsize - 1>(reach);
+
+            Lane hit {}, grew {};
+            for (int w = 0; w < words; w++) {
+                const Lane next = (
+                    reach[w] | up_x[w] | down_x[w]
+                    | ((up_y[w] | down_x_up_y[w]) & not_y_low[w])
+                    | ((down_y[w] | up_x_down_y[w]) & not_y_high[w])
+                ) & stones[w];
+                hit |= reach[w] & to_mask[w];
+                grew |= next ^ reach[w];
+                reach[w] = next;
+            }
+
+            // done once every lane has either won or stopped growing
+            unsigned won = 0, done = 0;
+            for (int j = 0; j < width; j++) {
+                won |= unsigned(hit[j] != 0) << j;
+                done |= unsigned(hit[j] != 0 || grew[j] == 0) << j;
+            }
+            if (done == (1u << width) - 1) {
+                return won;
+            }
+        }
+    }
+};
+
+/**
+ * Find the winner of every state in a span at once (see WinBatch).
+ *
+ * @param states the states to check.
+ * @param winners where to put the winners, winners[i] for states[i].
+ *                Must be at least as long as `states`.
+ */
+template<int bsize>
+void who_won_many(
+    std::span<const GameState::HexState<bsize>> states,
+    std::span<GameState::PLAYERS> winners
+) {
+    WinBatch<bsize>::who_won(states, winners);
+}
+
+}
+
+#endif // !HEX_AI_GAMESTATE_WINBATCH_HPP
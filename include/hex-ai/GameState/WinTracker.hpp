@@ -0,0 +1,212 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_WINTRACKER_HPP
+#define HEX_AI_GAMESTATE_WINTRACKER_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "hex-ai/GameState/Bitboard.hpp"
+#include "hex-ai/GameState/HexGeometry.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameState {
+
+/**
+ * WinTracker keeps the connected groups of both players' stones
+ * in a disjoint set forest, so that the winner of a board can be read off
+ * in constant time instead of searching the board for a connection.
+ *
+ * Besides one node per cell there are four virtual nodes, one per edge.
+ * A stone touching an edge is joined to that edge's node,
+ * and a player has won once their two edge nodes are in the same set.
+ *
+ * Stones are added one at a time with `add`. The most recently added stone
+ * can be taken back with `undo`, which replays a small log of the parent
+ * links each `add` changed. Any other change to the board needs a `rebuild`.
+ * There is no path compression, so that the log stays this small;
+ * union by rank keeps the trees shallow anyways.
+ *
+ * A zeroed WinTracker is an empty board, so constructing one is cheap.
+ */
+template<int bsize>
+class WinTracker {
+public:
+    static constexpr int cells = bsize * bsize;
+    // virtual nodes for the edges y = 0 and y = bsize - 1 (PLAYER_ONE)
+    // and the edges x = 0 and x = bsize - 1 (PLAYER_TWO)
+    static constexpr int ONE_LOW = cells, ONE_HIGH = cells + 1,
+                         TWO_LOW = cells + 2, TWO_HIGH = cells + 3;
+    static constexpr int nodes = cells + 4;
+
+    using Index = std::conditional_t<(nodes < 256), uint8_t, uint16_t>;
+    using Board = GameState::Bitboard<cells>;
+    using Geometry = GameState::HexGeometry<bsize>;
+
+    /**
+     * @return the player whose edges are connected, or PLAYER_NONE.
+     *         If (somehow) both are, PLAYER_ONE is reported.
+     */
+    GameState::PLAYERS winner() const {
+        return this->won;
+    }
+
+    /**
+     * Record a new stone on a previously empty cell.
+     *
+     * @param cell the cell the stone was placed on, x * bsize + y.
+     * @param whose the owner of the new stone.
+     * @param mine every stone of `whose`, including the new one.
+     */
+    void add(int cell, GameState::PLAYERS whose, const Board &mine) {
+        assert(whose == PLAYER_ONE || whose == PLAYER_TWO);
+        assert(mine.test(cell));
+        assert(this->made < cells);
+        const int x = cell / bsize, y = cell % bsize;
+        const Index before = this->logged;
+
+        for (int d = 0; d < Geometry::degree[cell]; d++) {
+            const int n = Geometry::neighbours[cell][d];
+            if (mine.test(n)) {
+                this->join(cell, n);
+            }
+        }
+
+        // and the edges it touches
+        if (whose == PLAYER_ONE) {
+            if (y == 0) {
+                this->join(cell, ONE_LOW);
+            }
+            if (y == bsize - 1) {
+                this->join(cell, ONE_HIGH);
+            }
+        } else {
+            if (x == 0) {
+                this->join(cell, TWO_LOW);
+            }
+            if (x == bsize - 1) {
+                this->join(cell, TWO_HIGH);
+            }
+        }
+
+        this->moves[this->made] = cell;
+        this->joins[this->made++] = this->logged - before;
+
+        // a new stone can only ever connect its own player's edges
+        if (whose == PLAYER_ONE) {
+            if (this->find(ONE_LOW) == this->find(ONE_HIGH)) {
+                this->won = PLAYER_ONE;
+            }
+        } else if (
+            this->won == PLAYER_NONE &&
+            this->find(TWO_LOW) == this->find(TWO_HIGH)
+        ) {
+            this->won = PLAYER_TWO;
+        }
+    }
+
+    /**
+     * Take back the stone at `cell`, if it was the most recently added one.
+     *
+     * @param cell the cell the stone should be removed from.
+     * @return true if the stone was taken back,
+     *         false if `cell` was not the last stone added (nothing changes).
+     */
+    bool undo(int cell) {
+        if (this->made == 0 || this->moves[this->made - 1] != cell) {
+            return false;
+        }
+        for (int joined = this->joins[--this->made]; joined > 0; joined--) {
+            const Entry &e = this->log[--this->logged];
+            this->rank[this->up[e.child] - 1] -= e.bumped;
+            this->up[e.child] = 0;
+        }
+        // and taking a stone away can only ever disconnect them
+        if (this->won != PLAYER_NONE) {
+            this->update_winner();
+        }
+        return true;
+    }
+
+    /**
+     * Forget everything and add every stone on the board from scratch.
+     *
+     * @param ones the stones of PLAYER_ONE.
+     * @param twos the stones of PLAYER_TWO.
+     */
+    void rebuild(const Board &ones, const Board &twos) {
+        *this = WinTracker();
+        Board placed[2];
+        for (int i = 0; i < cells; i++) {
+            if (ones.test(i)) {
+                this->add(i, PLAYER_ONE, placed[0].set(i));
+            } else if (twos.test(i)) {
+                this->add(i, PLAYER_TWO, placed[1].set(i));
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        // a root which was linked beneath another
+        Index child;
+        // whether that other root's rank went up because of it
+        uint8_t bumped;
+    };
+
+    // one more than the parent of each node, or 0 for the root of a set
+    std::array<Index, nodes> up {};
+    std::array<uint8_t, nodes> rank {};
+    // every union ever made reduces the amount of sets by one,
+    // so there can never be more than `nodes` of them to log
+    std::array<Entry, nodes> log {};
+    // the cells stones were added to, in order, and how many unions each made
+    std::array<Index, cells> moves {};
+    std::array<uint8_t, cells> joins {};
+    Index logged = 0;
+    uint16_t made = 0;
+    GameState::PLAYERS won = PLAYER_NONE;
+
+    int find(int i) const {
+        while (this->up[i]) {
+            i = this->up[i] - 1;
+        }
+        return i;
+    }
+
+    void join(int a, int b) {
+        a = this->find(a);
+        b = this->find(b);
+        if (a == b) {
+            return;
+        }
+        if (this->rank[a] > this->rank[b]) {
+            std::swap(a, b);
+        }
+        const uint8_t bumped = this->rank[a] == this->rank[b];
+        this->up[a] = b + 1;
+        this->rank[b] += bumped;
+        this->log[this->logged++] = { static_cast<Index>(a), bumped };
+    }
+
+    void update_winner() {
+        if (this->find(ONE_LOW) == this->find(ONE_HIGH)) {
+            this->won = PLAYER_ONE;
+        } else if (this->find(TWO_LOW) == this->find(TWO_HIGH)) {
+            this->won = PLAYER_TWO;
+        } else {
+            this->won = PLAYER_NONE;
+        }
+    }
+};
+
+}
+
+#endif // !HEX_AI_GAMESTATE_WINTRACKER_HPP
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_GAMESTATE_ZOBRIST_HPP
+#define HEX_AI_GAMESTATE_ZOBRIST_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "hex-ai/GameState/Bitboard.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+namespace GameState {
+
+/**
+ * Zobrist holds one random 64 bit key per player per cell of a bsize board.
+ * The Zobrist key of a board is the XOR of the keys of all its stones,
+ * which means placing or removing a single stone changes the key
+ * with a single XOR, and the key never needs to be computed from scratch.
+ *
+ * The keys are generated at compile time with splitmix64,
+ * so they are the same from one run (and one build) to the next.
+ */
+template<int bsize>
+class Zobrist {
+public:
+    static constexpr int cells = bsize * bsize;
+    using Board = GameState::Bitboard<cells>;
+
+    /**
+     * @param cell the index of the cell, x * bsize + y.
+     * @param whose PLAYER_ONE or PLAYER_TWO.
+     * @return the key for a stone of `whose` on `cell`.
+     */
+    static constexpr uint64_t key(int cell, GameState::PLAYERS whose) {
+        assert(cell >= 0 && cell < cells);
+        assert(whose == PLAYER_ONE || whose == PLAYER_TWO);
+        return keys[whose - 1][cell];
+    }
+
+    /**
+     * Compute the key of a whole board from scratch.
+     *
+     * @param ones the stones of PLAYER_ONE.
+     * @param twos the stones of PLAYER_TWO.
+     * @return the XOR of the keys of every stone on the board.
+     */
+    static constexpr uint64_t of(const Board &ones, const Board &twos) {
+        uint64_t k = 0;
+        for (int i = ones.next(); i < cells; i = ones.next(i + 1)) {
+            k ^= keys[0][i];
+        }
+        for (int i = twos.next(); i < cells; i = twos.next(i + 1)) {
+            k ^= keys[1][i];
+        }
+        return k;
+    }
+
+    /**
+     * @param cell the index of the cell, x * bsize + y.
+     * @param whose PLAYER_ONE or PLAYER_TWO.
+     * @return the key a stone of `whose` on `cell` has
+     *         once the board is rotated by 180 degrees.
+     */
+    static constexpr uint64_t rotated_key(int cell, GameState::PLAYERS whose) {
+        return key(cells - 1 - cell, whose);
+    }
+
+private:
+    static constexpr uint64_t splitmix64(uint64_t &state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr std::array<std::array<uint64_t, cells>, 2> keys = [] {
+        std::array<std::array<uint64_t, cells>, 2> k {};
+        // a different stream per board size
+        uint64_t state = bsize;
+        for (auto &player : k) {
+            for (uint64_t &cell : player) {
+                cell = splitmix64(state);
+            }
+        }
+        return k;
+    }();
+};
+
+}
+
+#endif // !HEX_AI_GAMESTATE_ZOBRIST_HPP
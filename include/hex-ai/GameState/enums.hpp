@@ -5,6 +5,7 @@ namespace GameState {
 
 enum PLAYERS : unsigned char { PLAYER_NONE, PLAYER_ONE, PLAYER_TWO };
 enum AXIS { VERTICAL, HORIZONTAL, BOTH };
+enum WIN_CHECK { WIN_SEARCH, WIN_UNION_FIND, WIN_FLOOD };
 
 }
 
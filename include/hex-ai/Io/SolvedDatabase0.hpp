@@ -0,0 +1,401 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_IO_SOLVEDDATABASE0_HPP
+#define HEX_AI_IO_SOLVEDDATABASE0_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Io/io_enums.hpp"
+
+namespace Io {
+
+/**
+ * SolvedDatabase0 holds what a SolvedDatabase file (version 0) looks like,
+ * for board sizes up to 5x5.
+ *
+ * A file holds whether player one wins from each of a set of states
+ * of a normal game, one where player one moved first and the players
+ * took turns, so whose turn it is follows from the stones:
+ * player one's if both have as many, player two's if player one has one more.
+ *
+ * The file is a 16 byte header, the file type, version and board size
+ * in a byte each, 5 bytes of padding, and the amount of states as a uint64_t.
+ * After that comes a uint64_t record for each state, in increasing order,
+ * so that the file can be searched where it is (see SolvedDatabase0Reader).
+ * A record is the key of the state shifted up one bit,
+ * with the low bit set if player one wins.
+ * The key of a board is player one's stones above player two's
+ * (as their Bitboards), and the key of a state is the smaller key
+ * of its board as it is and rotated by 180 degrees, which is the same game.
+ * Everything is in the byte order of the machine that wrote it.
+ */
+template<int bsize>
+struct SolvedDatabase0 {
+    static_assert(2 * bsize * bsize + 1 <= 64, "a record must fit in 64 bits");
+    static constexpr int cells = bsize * bsize;
+    static constexpr size_t header_size = 16;
+
+    /**
+     * @return the key of `state`, the same for both orientations of its board.
+     */
+    static uint64_t key_of(const GameState::HexState<bsize> &state) {
+        const auto &one = state.stones_of(GameState::PLAYER_ONE);
+        const auto &two = state.stones_of(GameState::PLAYER_TWO);
+        return std::min(
+            one.word(0) << cells | two.word(0),
+            one.reversed().word(0) << cells | two.reversed().word(0)
+        );
+    }
+
+    /**
+     * @return whose turn it is in `state` if it could come up in a normal game,
+     *         or PLAYER_NONE if it couldn't.
+     */
+    static GameState::PLAYERS to_move(const GameState::HexState<bsize> &state) {
+        const int ones = state.stones_of(GameState::PLAYER_ONE).count();
+        const int twos = state.stones_of(GameState::PLAYER_TWO).count();
+        return ones == twos ? GameState::PLAYER_ONE
+            : ones == twos + 1 ? GameState::PLAYER_TWO
+            : GameState::PLAYER_NONE;
+    }
+};
+
+/**
+ * SolvedDatabase0Writer<bsize> collects solved states and writes them
+ * as a SolvedDatabase file of version 0 (see SolvedDatabase0).
+ * Since the records have to be sorted, nothing is written until finish
+ * (or destruction of this object).
+ *
+ * Records are kept in memory only a run at a time: when a run fills up,
+ * it is sorted and put in a temporary file, and finish merges the runs
+ * into the stream. So a writer holds at most `run_size` records in memory,
+ * however many states are pushed, and needs as much space for temporary files
+ * as the file it writes.
+ */
+template<int bsize>
+class SolvedDatabase0Writer {
+public:
+    enum ERRORS { CLEAR, BAD_WRITE };
+
+    /**
+     * @param stream where to write the file.
+     * @param run_size how many records to keep in memory (8 bytes each)
+     *                 before putting them in a temporary file.
+     */
+    explicit SolvedDatabase0Writer(std::ostream &stream, size_t run_size = size_t(1) << 22)
+        : stream(stream), run_size(std::max<size_t>(run_size, 1)) {}
+
+    SolvedDatabase0Writer(const SolvedDatabase0Writer &) = delete;
+    SolvedDatabase0Writer &operator=(const SolvedDatabase0Writer &) = delete;
+
+    ~SolvedDatabase0Writer() {
+        this->finish();
+    }
+
+    /**
+     * @param state a state which could come up in a normal game.
+     *              Pushing it or its rotation again does nothing.
+     * @param one_wins whether player one wins `state`.
+     */
+    void push(const GameState::HexState<bsize> &state, bool one_wins) {
+        assert(SolvedDatabase0<bsize>::to_move(state) != GameState::PLAYER_NONE);
+        if (this->finished) {
+            return;
+        }
+        this->records.push_back(SolvedDatabase0<bsize>::key_of(state) << 1 | one_wins);
+        if (this->records.size() >= this->run_size) {
+            this->spill();
+        }
+    }
+
+    /**
+     * Write out every state pushed so far. Anything pushed after this is ignored.
+     *
+     * @return CLEAR, or BAD_WRITE if the stream (or a temporary file)
+     *         could not be written to.
+     */
+    unsigned int finish() {
+        if (this->finished) {
+            return this->error_state;
+        }
+        this->finished = true;
+
+        // the count goes first, so with runs to merge they are merged once
+        // just to count them, and again to write them
+        uint64_t count = 0;
+        if (this->runs.empty()) {
+            sort_run(this->records);
+            count = this->records.size();
+        } else {
+            this->spill();
+            this->merge([&count](uint64_t) { count++; });
+        }
+
+        unsigned char header[SolvedDatabase0<bsize>::header_size] {};
+        header[0] = Io::SOLVED_DATABASE;
+        header[1] = 0;
+        header[2] = bsize;
+        std::memcpy(header + 8, &count, sizeof(count));
+        this->stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+        if (this->runs.empty()) {
+            this->write_records(this->records.data(), this->records.size());
+        } else {
+            this->records.clear();
+            this->merge([this](uint64_t record) {
+                this->records.push_back(record);
+                if (this->records.size() == merge_buffer) {
+                    this->write_records(this->records.data(), this->records.size());
+                    this->records.clear();
+                }
+            });
+            this->write_records(this->records.data(), this->records.size());
+        }
+        this->count = count;
+        this->records = std::vector<uint64_t>();
+        this->runs.clear();
+        this->stream.flush();
+        if (!this->stream) {
+            this->error_state = BAD_WRITE;
+        }
+        return this->error_state;
+    }
+
+    /**
+     * @return how many states finish wrote, without repeats, or 0 before finish.
+     */
+    uint64_t size() const {
+        return this->count;
+    }
+
+    unsigned int read_err() const {
+        return this->error_state;
+    }
+
+private:
+    // how many records of each run are read in at a time while merging
+    static constexpr size_t merge_buffer = 1 << 12;
+
+    struct CloseFile {
+        void operator()(std::FILE *file) const {
+            std::fclose(file);
+        }
+    };
+
+    std::ostream &stream;
+    size_t run_size;
+    // the run being pushed to
+    std::vector<uint64_t> records;
+    // the runs already full, each sorted without repeats, in a temporary file
+    std::vector<std::unique_ptr<std::FILE, CloseFile>> runs;
+    uint64_t count = 0;
+    bool finished = false;
+    unsigned int error_state = CLEAR;
+
+    static void sort_run(std::vector<uint64_t> &run) {
+        std::sort(run.begin(), run.end());
+        run.erase(std::unique(run.begin(), run.end()), run.end());
+    }
+
+    // sort the run being pushed to and move it to a temporary file
+    void spill() {
+        sort_run(this->records);
+        std::unique_ptr<std::FILE, CloseFile> file(std::tmpfile());
+        if (!file || std::fwrite(this->records.data(), sizeof(uint64_t), this->records.size(), file.get())
+            != this->records.size()) {
+            this->error_state = BAD_WRITE;
+        } else {
+            this->runs.push_back(std::move(file));
+        }
+        this->records.clear();
+    }
+
+    void write_records(const uint64_t *data, size_t amount) {
+        this->stream.write(
+            reinterpret_cast<const char *>(data),
+            static_cast<std::streamsize>(amount * sizeof(uint64_t))
+        );
+    }
+
+    // call `emit` on every record of every run, in order and without repeats
+    template<class F>
+    void merge(F &&emit) {
+        struct Cursor {
+            std::FILE *file;
+            std::vector<uint64_t> buffer;
+            size_t at = 0;
+            size_t have = 0;
+
+            bool fill() {
+                this->at = 0;
+                this->have = std::fread(this->buffer.data(), sizeof(uint64_t), this->buffer.size(), this->file);
+                return this->have > 0;
+            }
+        };
+        using Head = std::pair<uint64_t, size_t>;
+        std::vector<Cursor> cursors;
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        for (auto &run : this->runs) {
+            std::rewind(run.get());
+            cursors.push_back(Cursor {run.get(), std::vector<uint64_t>(merge_buffer)});
+            if (cursors.back().fill()) {
+                heads.emplace(cursors.back().buffer[0], cursors.size() - 1);
+            }
+        }
+
+        bool any = false;
+        uint64_t last = 0;
+        while (!heads.empty()) {
+            const auto [record, i] = heads.top();
+            heads.pop();
+            if (!any || record != last) {
+                emit(record);
+                last = record;
+                any = true;
+            }
+            Cursor &cursor = cursors[i];
+            if (++cursor.at < cursor.have || cursor.fill()) {
+                heads.emplace(cursor.buffer[cursor.at], i);
+            }
+        }
+        for (const Cursor &cursor : cursors) {
+            if (std::ferror(cursor.file)) {
+                this->error_state = BAD_WRITE;
+            }
+        }
+    }
+};
+
+/**
+ * SolvedDatabase0Reader<bsize> maps a SolvedDatabase file of version 0
+ * (see SolvedDatabase0) into memory and looks states up in it
+ * with a binary search, so opening even a large file costs nothing
+ * until it is used, and every process using the same file shares
+ * the pages of it that are in memory.
+ */
+template<int bsize>
+class SolvedDatabase0Reader {
+public:
+    enum ERRORS { CLEAR, BAD_OPEN, BAD_HEADER };
+
+    /**
+     * The error status of this object is set immediately.
+     *
+     * @param path the file to read.
+     */
+    explicit SolvedDatabase0Reader(const std::string &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            this->error_state = BAD_OPEN;
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            this->error_state = BAD_OPEN;
+            return;
+        }
+        this->length = static_cast<size_t>(info.st_size);
+        if (this->length < SolvedDatabase0<bsize>::header_size) {
+            ::close(fd);
+            this->error_state = BAD_HEADER;
+            return;
+        }
+        void *mapped = ::mmap(nullptr, this->length, PROT_READ, MAP_SHARED, fd, 0);
+        // the mapping keeps the file open on its own
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            this->error_state = BAD_OPEN;
+            return;
+        }
+        this->mapping = mapped;
+
+        const auto *header = static_cast<const unsigned char *>(mapped);
+        uint64_t count;
+        std::memcpy(&count, header + 8, sizeof(count));
+        if (header[0] != Io::SOLVED_DATABASE || header[1] != 0 || header[2] != bsize
+            || (this->length - SolvedDatabase0<bsize>::header_size) / sizeof(uint64_t) != count
+            || (this->length - SolvedDatabase0<bsize>::header_size) % sizeof(uint64_t) != 0) {
+            this->error_state = BAD_HEADER;
+            return;
+        }
+        this->records = reinterpret_cast<const uint64_t *>(header + SolvedDatabase0<bsize>::header_size);
+        this->count = count;
+        // lookups jump all over the file
+        ::madvise(mapped, this->length, MADV_RANDOM);
+    }
+
+    SolvedDatabase0Reader(const SolvedDatabase0Reader &) = delete;
+    SolvedDatabase0Reader &operator=(const SolvedDatabase0Reader &) = delete;
+
+    ~SolvedDatabase0Reader() {
+        if (this->mapping) {
+            ::munmap(this->mapping, this->length);
+        }
+    }
+
+    /**
+     * @param state a state.
+     * @param mover the player to move in `state`.
+     * @return whether player one wins `state`, or nothing if it isn't in the file.
+     *         A state where it is not `mover`'s turn in a normal game
+     *         is never in the file, whatever its stones.
+     */
+    std::optional<bool> one_wins(const GameState::HexState<bsize> &state, GameState::PLAYERS mover) const {
+        if (this->count == 0 || SolvedDatabase0<bsize>::to_move(state) != mover) {
+            return std::nullopt;
+        }
+        const uint64_t record = SolvedDatabase0<bsize>::key_of(state) << 1;
+        const uint64_t *end = this->records + this->count;
+        const uint64_t *found = std::lower_bound(this->records, end, record);
+        if (found == end || (*found >> 1) != (record >> 1)) {
+            return std::nullopt;
+        }
+        return (*found & 1) != 0;
+    }
+
+    /**
+     * @return how many states are in the file.
+     */
+    size_t size() const {
+        return this->count;
+    }
+
+    unsigned int read_err() const {
+        return this->error_state;
+    }
+
+private:
+    void *mapping = nullptr;
+    size_t length = 0;
+    const uint64_t *records = nullptr;
+    size_t count = 0;
+    unsigned int error_state = CLEAR;
+};
+
+}
+
+#endif // !HEX_AI_IO_SOLVEDDATABASE0_HPP
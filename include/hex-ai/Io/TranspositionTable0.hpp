@@ -0,0 +1,236 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_IO_TRANSPOSITIONTABLE0_HPP
+#define HEX_AI_IO_TRANSPOSITIONTABLE0_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hex-ai/GameSolve/TranspositionTable.hpp"
+#include "hex-ai/Io/io_enums.hpp"
+
+namespace Io {
+
+/**
+ * TranspositionTable0 holds what a TranspositionTable snapshot file
+ * (version 0) looks like: everything a GameSolve::TranspositionTable
+ * had in it, so that a later run can start from where it left off.
+ *
+ * The file is a 64 byte header, the file type, version, board size,
+ * whether the solvers that filled the table used symmetry (see
+ * HexState::canonical), data_bits of the table and the generation it was in
+ * in a byte each, 2 bytes of padding, the amount of entries as a uint64_t,
+ * and padding up to 64 bytes.
+ * After that come all of the entries, empty ones too, as the uint64_t words
+ * the table keeps them as and in the same order, so the file can be
+ * mapped into memory and used as a table right where it is
+ * (see TranspositionTable0Reader). The header is as long as a bucket
+ * of the table so that the entries stay aligned to buckets.
+ * Everything is in the byte order of the machine that wrote it.
+ *
+ * The keys of a table mean different states on different board sizes
+ * and with or without symmetry, so a file is only read for the
+ * board size and use of symmetry it was written with.
+ */
+struct TranspositionTable0 {
+    static constexpr size_t header_size = 64;
+};
+
+/**
+ * TranspositionTable0Writer writes snapshots of TranspositionTables
+ * as TranspositionTable files of version 0 (see TranspositionTable0).
+ */
+class TranspositionTable0Writer {
+public:
+    enum ERRORS { CLEAR, BAD_WRITE };
+
+    /**
+     * @param stream where to write.
+     * @param bsize the board size of the solvers using the tables to write.
+     * @param use_symmetry whether those solvers use symmetry.
+     */
+    TranspositionTable0Writer(std::ostream &stream, int bsize, bool use_symmetry)
+        : stream(stream), bsize(bsize), use_symmetry(use_symmetry) {}
+
+    TranspositionTable0Writer(const TranspositionTable0Writer &) = delete;
+    TranspositionTable0Writer &operator=(const TranspositionTable0Writer &) = delete;
+
+    /**
+     * Write out everything in `table`.
+     * Other threads may use the table while this runs, but whether
+     * what they store makes it into the file is up to chance.
+     *
+     * @param table the table to write.
+     * @return CLEAR, or BAD_WRITE if the stream could not be written to.
+     */
+    unsigned int write(const GameSolve::TranspositionTable &table) {
+        unsigned char header[TranspositionTable0::header_size] {};
+        header[0] = Io::TRANSPOSITION_TABLE;
+        header[1] = 0;
+        header[2] = static_cast<unsigned char>(this->bsize);
+        header[3] = this->use_symmetry;
+        header[4] = GameSolve::TranspositionTable::data_bits;
+        header[5] = static_cast<unsigned char>(table.current_generation());
+        const uint64_t count = table.capacity();
+        std::memcpy(header + 8, &count, sizeof(count));
+        this->stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+        // a few pages of entries at a time
+        constexpr size_t chunk = 4096;
+        uint64_t words[chunk];
+        for (size_t i = 0; i < count && this->stream; i += chunk) {
+            const size_t n = std::min(chunk, count - i);
+            for (size_t j = 0; j < n; j++) {
+                words[j] = table.entry(i + j);
+            }
+            this->stream.write(reinterpret_cast<const char *>(words), static_cast<std::streamsize>(n * sizeof(uint64_t)));
+        }
+        this->stream.flush();
+        if (!this->stream) {
+            this->error_state = BAD_WRITE;
+        }
+        return this->error_state;
+    }
+
+    unsigned int read_err() const {
+        return this->error_state;
+    }
+
+private:
+    std::ostream &stream;
+    int bsize;
+    bool use_symmetry;
+    unsigned int error_state = CLEAR;
+};
+
+/**
+ * TranspositionTable0Reader maps a TranspositionTable file of version 0
+ * (see TranspositionTable0) into memory and hands it over to
+ * a GameSolve::TranspositionTable that uses it right where it is.
+ * The mapping is private, so the file is only ever read:
+ * a page of it is read in the first time the table touches it,
+ * and copied the first time the table stores to it,
+ * which makes loading even a large snapshot cost nothing up front.
+ */
+class TranspositionTable0Reader {
+public:
+    enum ERRORS { CLEAR, BAD_OPEN, BAD_HEADER };
+
+    /**
+     * The error status of this object is set immediately.
+     *
+     * @param path the file to read.
+     * @param bsize the board size of the solvers that will use the table.
+     * @param use_symmetry whether those solvers use symmetry.
+     */
+    TranspositionTable0Reader(const std::string &path, int bsize, bool use_symmetry) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            this->error_state = BAD_OPEN;
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            this->error_state = BAD_OPEN;
+            return;
+        }
+        this->length = static_cast<size_t>(info.st_size);
+        if (this->length < TranspositionTable0::header_size) {
+            ::close(fd);
+            this->error_state = BAD_HEADER;
+            return;
+        }
+        // writable, but private, so stores go to copies of the pages and never to the file
+        void *mapped = ::mmap(nullptr, this->length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        // the mapping keeps the file open on its own
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            this->error_state = BAD_OPEN;
+            return;
+        }
+        this->mapping = mapped;
+
+        const auto *header = static_cast<const unsigned char *>(mapped);
+        uint64_t count;
+        std::memcpy(&count, header + 8, sizeof(count));
+        if (header[0] != Io::TRANSPOSITION_TABLE || header[1] != 0
+            || header[2] != bsize || header[3] != use_symmetry
+            || header[4] != GameSolve::TranspositionTable::data_bits
+            || header[5] == 0 || header[5] > 63
+            || count < 8 || (count & (count - 1)) != 0
+            || (this->length - TranspositionTable0::header_size) / sizeof(uint64_t) != count
+            || (this->length - TranspositionTable0::header_size) % sizeof(uint64_t) != 0) {
+            this->error_state = BAD_HEADER;
+            return;
+        }
+        this->count = count;
+        this->generation = header[5];
+        // probes jump all over the table
+        ::madvise(mapped, this->length, MADV_RANDOM);
+    }
+
+    TranspositionTable0Reader(const TranspositionTable0Reader &) = delete;
+    TranspositionTable0Reader &operator=(const TranspositionTable0Reader &) = delete;
+
+    ~TranspositionTable0Reader() {
+        if (this->mapping) {
+            ::munmap(this->mapping, this->length);
+        }
+    }
+
+    /**
+     * Hand the file over to a table, which keeps it mapped for as long as it lives.
+     *
+     * @return the table in the file, or nullptr if the file couldn't be read
+     *         or was already handed over.
+     */
+    std::unique_ptr<GameSolve::TranspositionTable> table() {
+        if (this->error_state != CLEAR || this->mapping == nullptr) {
+            return nullptr;
+        }
+        const size_t length = this->length;
+        std::shared_ptr<void> storage(this->mapping, [length](void *mapped) {
+            ::munmap(mapped, length);
+        });
+        auto *words = reinterpret_cast<uint64_t *>(static_cast<unsigned char *>(this->mapping) + TranspositionTable0::header_size);
+        this->mapping = nullptr;
+        return std::make_unique<GameSolve::TranspositionTable>(words, this->count, this->generation, std::move(storage));
+    }
+
+    /**
+     * @return how many entries the table in the file has room for.
+     */
+    size_t size() const {
+        return this->count;
+    }
+
+    unsigned int read_err() const {
+        return this->error_state;
+    }
+
+private:
+    void *mapping = nullptr;
+    size_t length = 0;
+    size_t count = 0;
+    uint64_t generation = 0;
+    unsigned int error_state = CLEAR;
+};
+
+}
+
+#endif // !HEX_AI_IO_TRANSPOSITIONTABLE0_HPP
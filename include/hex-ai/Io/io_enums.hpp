@@ -13,6 +13,8 @@ namespace Io {
 enum HEX_FILE_TYPE: uint8_t {
     UNRECOGNIZED,
     GAMESTATE_BOOL,
+    SOLVED_DATABASE,
+    TRANSPOSITION_TABLE,
     END
 };
 
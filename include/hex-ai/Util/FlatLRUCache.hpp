@@ -0,0 +1,299 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_UTIL_FLATLRUCACHE_HPP
+#define HEX_AI_UTIL_FLATLRUCACHE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Cache {
+
+/**
+ * FlatLRUCache is a fixed capacity hash map which, once full, makes room
+ * for new items by forgetting whichever item was least recently inserted
+ * or looked up, just like LRUCache, but laid out for fewer cache misses.
+ *
+ * It is an open addressing table in the style of Swiss tables:
+ * slots come in groups of 7, and each group has a control word
+ * with a byte for each of its slots, either saying it is empty
+ * or holding 7 bits of the hash of its item, and a byte counting
+ * how many items had to go past the group because it was full.
+ * A probe compares all 7 bytes of a group at once, only looks at the keys
+ * of items whose bits match, and goes on to another group only if
+ * some item went past it. How far along the next group is depends on
+ * the hash, so keys that start at the same group don't pile up after it.
+ * The order the items were used in is a list through the slots,
+ * kept apart from the items so that probes don't have to step over it,
+ * and each item's place in the list remembers the group its hash put it in,
+ * so forgetting the least recently used item never hashes its key,
+ * and no item ever has to move.
+ *
+ * The amount of groups is a power of two, so that finding a key's group
+ * takes a mask, with at least 4 slots to every 3 items.
+ * An item that had to go past its group stays where it was put
+ * even once room opens up behind it, so in a full cache that has been
+ * making room for a while, more and more groups have had some item
+ * go past them, which is what makes a probe for a key that isn't there
+ * go on to other groups. How many depends on how full the slots are:
+ * at 3 items to every 4 slots, such a probe reads under 3 control words
+ * on average, where at 9 items to every 10 it reads more than 20.
+ * A probe that finds its key reads a control word or two and an item.
+ *
+ * Keys are hashed with a default constructed `Hash`, and its result is mixed
+ * before use, so a `Hash` that is the identity (like std::hash of an integer)
+ * does fine.
+ */
+template<class Key, class Value, class Hash = std::hash<Key>>
+class FlatLRUCache {
+public:
+    /**
+     * @param capacity the most items to keep, at least 1.
+     */
+    explicit FlatLRUCache(unsigned int capacity) : max_capacity(capacity) {
+        assert(capacity > 0);
+        // at most 3 items to every 4 slots
+        const size_t groups = std::bit_ceil((4 * size_t(capacity) + 3 * group_size - 1) / (3 * group_size));
+        this->mask = groups - 1;
+        this->control.assign(groups, all_empty);
+        this->items.resize(groups * group_size);
+        this->recency.resize(groups * group_size);
+        this->probes.resize(groups + 1);
+    }
+
+    /**
+     * Insert inserts a key value pair into the cache that does not currently exist.
+     * Behavior is not defined if the key is already in the cache.
+     *
+     * @param k Key to insert into the cache.
+     * @param v Value to associate with the given key.
+     */
+    void insert(const Key &k, const Value &v) {
+        if (this->used == this->max_capacity) {
+            this->clear_slot(this->oldest);
+        } else {
+            this->used++;
+        }
+
+        const uint64_t mixed = mix(k);
+        const uint32_t home = this->home_of(mixed);
+        const uint32_t step = this->step_of(fingerprint(mixed));
+        uint32_t g = home;
+        uint32_t length = 1;
+        uint64_t open;
+        while (!(open = match_empty(this->control[g]))) {
+            this->add_overflow(g, 1);
+            g = this->next(g, step);
+            length++;
+        }
+        this->probes[length]++;
+        this->longest = std::max(this->longest, length);
+        const uint32_t slot = g * group_size + std::countr_zero(open) / 8;
+        this->set_byte(slot, fingerprint(mixed));
+        this->items[slot] = Item {k, v};
+        this->recency[slot].home = home;
+        this->link_newest(slot);
+    }
+
+    /**
+     * Looks up a key in the cache to see if a value is associated with it.
+     * If the key is found, v is set to the value associated with it
+     * and `true` is returned.
+     * Otherwise, `false` is returned.
+     * No promises about the value of v is the key is not found.
+     *
+     * @param k A key to look up in the cache.
+     * @param v An outparameter for the value of the key `k` if found.
+     * @return `true` if the key was found, else `false`.
+     */
+    [[nodiscard("Return value determines if value v is valid.")]]
+    bool lookup(const Key &k, Value &v) {
+        Value *found = this->find(k);
+        if (found == nullptr) {
+            return false;
+        }
+        v = *found;
+        return true;
+    }
+
+    /**
+     * Looks up a key in the cache like lookup does, but gives back
+     * the value itself, so that it can be changed in place.
+     *
+     * @param k A key to look up in the cache.
+     * @return A pointer to the value of the key `k`, or nullptr if it is not found.
+     *         The pointer is good until the next insert.
+     */
+    Value *find(const Key &k) {
+        const uint64_t mixed = mix(k);
+        const uint64_t bits = fingerprint(mixed);
+        const uint32_t step = this->step_of(bits);
+        uint32_t g = this->home_of(mixed);
+        for (uint32_t length = 1; length <= this->longest; length++, g = this->next(g, step)) {
+            const uint64_t word = this->control[g];
+            for (uint64_t found = match(word, bits); found; found &= found - 1) {
+                const uint32_t slot = g * group_size + std::countr_zero(found) / 8;
+                if (this->items[slot].key == k) {
+                    this->touch(slot);
+                    return &this->items[slot].value;
+                }
+            }
+            if ((word >> overflow_shift) == 0) {
+                break;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @return how many items are in the cache.
+     */
+    unsigned int size() const {
+        return this->used;
+    }
+
+    /**
+     * @return the most items the cache keeps.
+     */
+    unsigned int capacity() const {
+        return this->max_capacity;
+    }
+
+private:
+    static constexpr uint32_t none = UINT32_MAX;
+    static constexpr int group_size = 7;
+    // the top byte of a control word is its overflow count, which sticks once it gets to 255
+    static constexpr int overflow_shift = 8 * group_size;
+    static constexpr uint64_t overflow_stuck = 0xff;
+    // a slot's byte is 0x80 if it is empty, or else the 7 bits of its item's hash
+    static constexpr uint64_t empty = 0x80;
+    static constexpr uint64_t lsbs = 0x0001010101010101;
+    static constexpr uint64_t msbs = 0x0080808080808080;
+    static constexpr uint64_t all_empty = empty * lsbs;
+
+    struct Item {
+        Key key;
+        Value value;
+    };
+
+    struct Recency {
+        uint32_t newer = none;
+        uint32_t older = none;
+        // the group the item's hash put it in
+        uint32_t home = 0;
+    };
+
+    unsigned int max_capacity;
+    unsigned int used = 0;
+    // the slots of the most and least recently used items
+    uint32_t newest = none;
+    uint32_t oldest = none;
+    // the amount of groups less one, for finding a key's group
+    size_t mask = 0;
+    std::vector<uint64_t> control;
+    std::vector<Item> items;
+    std::vector<Recency> recency;
+    // how many items took each amount of groups to find a slot, and the most any did,
+    // which is as far as a probe ever has to go even if every group has been passed
+    std::vector<uint32_t> probes;
+    uint32_t longest = 0;
+
+    static uint64_t mix(const Key &k) {
+        uint64_t h = Hash{}(k);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccd;
+        return h ^ h >> 33;
+    }
+
+    static uint64_t fingerprint(uint64_t mixed) {
+        return mixed & 0x7f;
+    }
+
+    // a byte with its high bit set for each slot of a group whose byte may be `bits`,
+    // which is sure to include every one that is (and often only those)
+    static uint64_t match(uint64_t word, uint64_t bits) {
+        const uint64_t x = (word & ~(uint64_t(0xff) << overflow_shift)) ^ (lsbs * bits);
+        return (x - lsbs) & ~x & msbs;
+    }
+
+    static uint64_t match_empty(uint64_t word) {
+        return word & msbs;
+    }
+
+    uint32_t home_of(uint64_t mixed) const {
+        return static_cast<uint32_t>((mixed >> 32) & this->mask);
+    }
+
+    // how many groups a probe moves along at a time, which depends on the bits of the hash
+    // in a slot's byte, so that keys sharing a home group mostly go different ways from it.
+    // Since the step is odd and the amount of groups a power of two, a probe gets to every group.
+    uint32_t step_of(uint64_t bits) const {
+        return static_cast<uint32_t>(2 * bits + 1);
+    }
+
+    uint32_t next(uint32_t g, uint32_t step) const {
+        return (g + step) & this->mask;
+    }
+
+    void set_byte(uint32_t slot, uint64_t byte) {
+        uint64_t &word = this->control[slot / group_size];
+        const int shift = 8 * (slot % group_size);
+        word = (word & ~(uint64_t(0xff) << shift)) | byte << shift;
+    }
+
+    void add_overflow(uint32_t g, int change) {
+        const uint64_t count = this->control[g] >> overflow_shift;
+        if (count != overflow_stuck) {
+            this->control[g] += uint64_t(change) << overflow_shift;
+        }
+    }
+
+    // forget the item in `slot`
+    void clear_slot(uint32_t slot) {
+        const uint32_t step = this->step_of(this->control[slot / group_size] >> 8 * (slot % group_size) & 0x7f);
+        this->unlink(slot);
+        this->set_byte(slot, empty);
+        uint32_t length = 1;
+        for (uint32_t g = this->recency[slot].home; g != slot / group_size; g = this->next(g, step)) {
+            this->add_overflow(g, -1);
+            length++;
+        }
+        this->probes[length]--;
+        while (this->longest > 0 && this->probes[this->longest] == 0) {
+            this->longest--;
+        }
+    }
+
+    void unlink(uint32_t slot) {
+        Recency &r = this->recency[slot];
+        (r.newer == none ? this->newest : this->recency[r.newer].older) = r.older;
+        (r.older == none ? this->oldest : this->recency[r.older].newer) = r.newer;
+    }
+
+    void link_newest(uint32_t slot) {
+        Recency &r = this->recency[slot];
+        r.newer = none;
+        r.older = this->newest;
+        (this->newest == none ? this->oldest : this->recency[this->newest].newer) = slot;
+        this->newest = slot;
+    }
+
+    void touch(uint32_t slot) {
+        if (slot != this->newest) {
+            this->unlink(slot);
+            this->link_newest(slot);
+        }
+    }
+};
+
+}
+
+#endif // !HEX_AI_UTIL_FLATLRUCACHE_HPP
@@ -13,19 +13,51 @@
 #ifndef CURLIBS_CACHE_LRUCACHE_HPP
 #define CURLIBS_CACHE_LRUCACHE_HPP
 
+#include <atomic>
 #include <functional>
 #include <iostream>
+#include <type_traits>
 
 namespace Cache {
 
-template<class Key, class Value>
+/**
+* How an LRUCache picks which item to forget to make room for a new one.
+*
+* LRU forgets the least recently inserted or looked up item,
+* which means every lookup that finds its key moves the item
+* to the front of a list, writing to it and its neighbors.
+*
+* CLOCK only approximates that (the second chance algorithm):
+* a lookup just marks the item it finds as referenced (if it wasn't already),
+* and to make room a hand sweeps around the items in turn,
+* unmarking marked ones and forgetting the first unmarked one.
+* Since the mark is atomic, lookups of a CLOCK cache write nothing else,
+* and any amount of threads can look up at once, as long as
+* no insert runs at the same time (like under the shared side
+* of a std::shared_mutex, with inserts taking the exclusive side).
+*/
+enum class Eviction { LRU, CLOCK };
+
+/**
+* LRUCache is a fixed capacity hash map which, once full, makes room for new
+* items by forgetting whichever item was least recently inserted or looked up
+* (or, with Eviction::CLOCK, an item that hasn't been in a while).
+* Keys are hashed with a default constructed `Hash`.
+*/
+template<class Key, class Value, class Hash = std::hash<Key>, Eviction eviction = Eviction::LRU>
 class LRUCache {
 public:
+    // what an LRU node has in place of a mark: nothing
+    struct Unmarked {};
+
     struct LLNode {
         LLNode *newer = nullptr;
         LLNode *older = nullptr;
         LLNode *bucket_next = nullptr;
         LLNode *bucket_prev = nullptr;
+        // whether the node was used since the hand last went past it,
+        // which only CLOCK has (and LRU doesn't make room for)
+        [[no_unique_address]] std::conditional_t<eviction == Eviction::CLOCK, std::atomic<bool>, Unmarked> referenced {};
         Value value;
         Key key;
     };
@@ -35,6 +67,8 @@ public:
     LLNode *newest = nullptr;
     LLNode *cache = nullptr;
     LLNode **map = nullptr;
+    // the next node the hand of CLOCK looks at
+    unsigned int hand = 0;
 
     void data_dump() {
         std::cout << "newest: " << this->newest << "\noldest: " << this->oldest << "\n";
@@ -74,19 +108,49 @@ public:
         // Remove the oldest node from the linked list
         LLNode *to_remove = this->oldest;
         this->oldest = to_remove->newer;
-        this->oldest->older = nullptr;
+        if (this->oldest == nullptr) {
+            // to_remove was the only node, as it is with a capacity of 1
+            this->newest = nullptr;
+        } else {
+            this->oldest->older = nullptr;
+        }
+
+        this->remove_from_map(to_remove);
+        return to_remove;
+    }
+
+    /**
+    * Sweeps the hand of CLOCK around to the first node not referenced since
+    * it last went past, unmarking the ones that were along the way,
+    * and removes that node from the hashmap.
+    * Assumes that the cache is full.
+    */
+    LLNode *delete_unreferenced() {
+        LLNode *to_remove;
+        while (true) {
+            to_remove = &this->cache[this->hand];
+            this->hand = this->hand + 1 == this->max_capacity ? 0 : this->hand + 1;
+            if (!to_remove->referenced.load(std::memory_order_relaxed)) {
+                break;
+            }
+            to_remove->referenced.store(false, std::memory_order_relaxed);
+        }
+
+        this->remove_from_map(to_remove);
+        return to_remove;
+    }
 
-        // Now remove the node from the hashmap
+    void remove_from_map(LLNode *to_remove) {
         LLNode *prev = to_remove->bucket_prev;
         LLNode *next = to_remove->bucket_next;
         if (prev == nullptr) {
             if (next == nullptr) {
                 // If to_remove was the only one in its bucket, remove the map's pointer to it
-                this->map[std::hash<Key>{}(to_remove->key) % this->max_capacity] = nullptr;
+                this->map[Hash{}(to_remove->key) % this->max_capacity] = nullptr;
             } else {
                 // If to_remove was the first thing of several in its bucket,
                 // you need the bucket to point to the next thing after to_remove
-                this->map[std::hash<Key>{}(to_remove->key) % this->max_capacity] = next;
+                this->map[Hash{}(to_remove->key) % this->max_capacity] = next;
                 next->bucket_prev = nullptr;
             }
         } else {
@@ -99,8 +163,6 @@ public:
                 next->bucket_prev = prev;
             }
         }
-
-        return to_remove;
     }
 
     /**
@@ -112,27 +174,34 @@ public:
     void insert(const Key &k, const Value &v) {
         // If it is full, delete an old item to make room first
         LLNode *placement;
-        if (this->used == this->max_capacity) {
-            placement = this->delete_oldest();
-        } else {
+        if (this->used < this->max_capacity) {
             placement = &(this->cache[this->used++]);
+        } else if constexpr (eviction == Eviction::CLOCK) {
+            placement = this->delete_unreferenced();
+        } else {
+            placement = this->delete_oldest();
         }
 
         // First put the key value pair into the cache
         placement->key = k;
         placement->value = v;
-        // Then hook it up to the front of the linked list
-        placement->newer = nullptr;
-        if (this->newest == nullptr) {
-            this->oldest = placement;
+        if constexpr (eviction == Eviction::CLOCK) {
+            // CLOCK has no list, and a new node gets one sweep of the hand to be used
+            placement->referenced.store(true, std::memory_order_relaxed);
         } else {
-            this->newest->newer = placement;
-            placement->older = this->newest;
+            // Then hook it up to the front of the linked list
+            placement->newer = nullptr;
+            if (this->newest == nullptr) {
+                this->oldest = placement;
+            } else {
+                this->newest->newer = placement;
+                placement->older = this->newest;
+            }
+            this->newest = placement;
         }
-        this->newest = placement;
         // Then find the bucket it belongs to - if the bucket is empty, put a pointer to it there.
         // If the bucket is not empty, add placement to the front of it
-        unsigned int bucket = std::hash<Key>{}(k) % this->max_capacity;
+        unsigned int bucket = Hash{}(k) % this->max_capacity;
 
         placement->bucket_next = this->map[bucket];
         this->map[bucket] = placement;
@@ -182,19 +251,42 @@ public:
     */
     [[nodiscard("Return value determines if value v is valid.")]]
     bool lookup(const Key &k, Value &v) {
+        Value *found = this->find(k);
+        if (found == nullptr) {
+            return false;
+        }
+        v = *found;
+        return true;
+    }
+
+    /**
+    * Looks up a key in the cache like lookup does, but gives back
+    * the value itself, so that it can be changed in place.
+    *
+    * @param k A key to look up in the cache.
+    * @return A pointer to the value of the key `k`, or nullptr if it is not found.
+    *         The pointer is good until the next insert.
+    */
+    Value *find(const Key &k) {
         // First look up to see if there are any items with that key in the map
-        LLNode *search = this->map[std::hash<Key>{}(k) % this->max_capacity];
+        LLNode *search = this->map[Hash{}(k) % this->max_capacity];
         if (search != nullptr) {
             do {
                 if (k == search->key) {
-                    v = search->value;
-                    this->update(search);
-                    return true;
+                    if constexpr (eviction == Eviction::CLOCK) {
+                        // only write if it changes anything, so the node's cache line can stay shared
+                        if (!search->referenced.load(std::memory_order_relaxed)) {
+                            search->referenced.store(true, std::memory_order_relaxed);
+                        }
+                    } else {
+                        this->update(search);
+                    }
+                    return &search->value;
                 }
                 search = search->bucket_next;
             } while (search != nullptr);
         }
-        return false;
+        return nullptr;
     }
 };
 
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_UTIL_PARSEARG_HPP
+#define HEX_AI_UTIL_PARSEARG_HPP
+
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+
+namespace Util {
+
+/**
+ * Read all of `arg` as a whole number no less than `low` and no more than `high`,
+ * telling the user what was wrong with it if it isn't one.
+ *
+ * @param arg a command line argument.
+ * @param name what the argument is, for the message.
+ * @return whether `arg` was such a number, in which case it is put in `out`.
+ */
+template<class T>
+bool parse_arg(const char *arg, const char *name, T low, T high, T &out) {
+    const std::string_view text(arg);
+    T value;
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || end != text.data() + text.size() || value < low || value > high) {
+        std::cerr << "hex-ai: " << name << " must be a whole number from " << low
+                  << " to " << high << ", not \"" << arg << "\".\n";
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+}
+
+#endif // !HEX_AI_UTIL_PARSEARG_HPP
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_UTIL_SHARDEDLRUCACHE_HPP
+#define HEX_AI_UTIL_SHARDEDLRUCACHE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "hex-ai/Util/LRUCache.hpp"
+
+namespace Cache {
+
+/**
+ * ShardedLRUCache is an LRUCache that any amount of threads can use at once.
+ * Its capacity is split evenly between `Shards` LRUCaches, each behind
+ * a lock of its own, and the hash of a key picks which shard it goes in,
+ * so threads only wait on each other when they want the same shard
+ * at the same time. Each shard forgets its own least recently used item
+ * to make room, so the cache as a whole only keeps roughly the most recently
+ * used items.
+ *
+ * With Eviction::CLOCK, a lookup only marks the item it finds (see Eviction),
+ * so lookups take their shard's lock shared, and any amount of threads
+ * can look up in the same shard at once; only inserts wait for each other.
+ * With Eviction::LRU every lookup moves an item, so it locks the shard
+ * as much as an insert does.
+ *
+ * Keys are hashed with a default constructed `Hash`.
+ * Picking the shard uses the top bits of the hash after mixing it,
+ * and the shard itself the hash modulo its capacity,
+ * so the two don't depend on the same bits.
+ */
+template<class Key, class Value, int Shards, class Hash = std::hash<Key>, Eviction eviction = Eviction::LRU>
+class ShardedLRUCache {
+    static_assert(Shards > 0 && std::has_single_bit(unsigned(Shards)), "the amount of shards must be a power of two");
+
+public:
+    /**
+     * @param capacity the most items to keep, split between the shards
+     *                 (but at least one for each).
+     */
+    explicit ShardedLRUCache(unsigned int capacity) {
+        const unsigned int each = std::max(capacity / Shards, 1u);
+        for (int i = 0; i < Shards; i++) {
+            this->shards.push_back(std::make_unique<Shard>(each));
+        }
+    }
+
+    /**
+     * Insert inserts a key value pair into the cache.
+     * Since another thread may have inserted the same key first,
+     * a key that is already in the cache has its value replaced.
+     *
+     * @param k Key to insert into the cache.
+     * @param v Value to associate with the given key.
+     */
+    void insert(const Key &k, const Value &v) {
+        Shard &shard = this->shard_of(k);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (Value *found = shard.cache.find(k)) {
+            *found = v;
+        } else {
+            shard.cache.insert(k, v);
+        }
+    }
+
+    /**
+     * Looks up a key in the cache to see if a value is associated with it.
+     * If the key is found, v is set to a copy of the value associated with it
+     * and `true` is returned.
+     * Otherwise, `false` is returned.
+     *
+     * @param k A key to look up in the cache.
+     * @param v An outparameter for the value of the key `k` if found.
+     * @return `true` if the key was found, else `false`.
+     */
+    [[nodiscard("Return value determines if value v is valid.")]]
+    bool lookup(const Key &k, Value &v) {
+        Shard &shard = this->shard_of(k);
+        if constexpr (eviction == Eviction::CLOCK) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            return shard.cache.lookup(k, v);
+        } else {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            return shard.cache.lookup(k, v);
+        }
+    }
+
+    /**
+     * @return how many items are in the cache. Anything that other threads
+     *         insert while this counts may or may not be counted.
+     */
+    unsigned int size() {
+        unsigned int used = 0;
+        for (const std::unique_ptr<Shard> &shard : this->shards) {
+            std::shared_lock<std::shared_mutex> lock(shard->mutex);
+            used += shard->cache.used;
+        }
+        return used;
+    }
+
+private:
+    // each shard gets cache lines to itself, so that locking one doesn't slow down its neighbors
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+        LRUCache<Key, Value, Hash, eviction> cache;
+
+        explicit Shard(unsigned int capacity) : cache(capacity) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard &shard_of(const Key &k) {
+        if constexpr (Shards == 1) {
+            return *this->shards[0];
+        } else {
+            const uint64_t mixed = uint64_t(Hash{}(k)) * 0x9e3779b97f4a7c15;
+            return *this->shards[mixed >> (64 - std::countr_zero(unsigned(Shards)))];
+        }
+    }
+};
+
+}
+
+#endif // !HEX_AI_UTIL_SHARDEDLRUCACHE_HPP
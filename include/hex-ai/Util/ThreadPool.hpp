@@ -0,0 +1,303 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_UTIL_THREADPOOL_HPP
+#define HEX_AI_UTIL_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Util {
+
+/**
+ * ThreadPool is a fixed set of worker threads that run tasks,
+ * where every worker has its own queue of tasks.
+ *
+ * A task submitted from inside a worker goes onto that worker's own queue,
+ * and a worker always takes the newest task from its own queue first,
+ * so a task which splits into smaller ones tends to work through them
+ * depth first, in the cache of the core it is already running on.
+ * A worker whose queue is empty steals the oldest task from another queue,
+ * which is usually the biggest piece of work left there.
+ *
+ * Tasks are meant to be run and waited for with a TaskGroup.
+ * A thread waiting on a TaskGroup runs that group's queued tasks until
+ * the group is done, so tasks can wait on tasks of their own without
+ * ever tying up a worker. It never picks up tasks of other groups,
+ * which could belong to work the waiting task knows nothing about
+ * (and could take far longer than the group it is waiting on).
+ * Once none of the group's tasks are left in the queues,
+ * it sleeps until a task is submitted or finishes.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+    class TaskGroup;
+
+    /**
+     * @param threads the amount of worker threads (at least one is made).
+     */
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) {
+            threads = 1;
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            this->queues.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            this->workers.emplace_back([this, i] { this->work(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Runs every task already submitted, then stops the workers.
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->sleep_mutex);
+            this->stopping = true;
+        }
+        this->wake.notify_all();
+        for (std::thread &t : this->workers) {
+            t.join();
+        }
+    }
+
+    /**
+     * @return the amount of worker threads.
+     */
+    unsigned size() const {
+        return static_cast<unsigned>(this->queues.size());
+    }
+
+    /**
+     * Queue up a task to be run by some worker.
+     */
+    void submit(Task task) {
+        this->submit(std::move(task), nullptr);
+    }
+
+    /**
+     * Run a single queued task on the calling thread, if there is one.
+     *
+     * @return true if a task was run.
+     */
+    bool run_one() {
+        return this->run_one(nullptr);
+    }
+
+    /**
+     * TaskGroup is a set of tasks run on a ThreadPool which can be waited on together.
+     * It must be waited on before it goes out of scope,
+     * since its tasks usually refer to the scope it was made in.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool &pool) : pool(pool) {}
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        ~TaskGroup() {
+            this->wait();
+        }
+
+        /**
+         * Start `f` on the pool as a part of this group.
+         * If `f` throws, the first such exception is thrown again by wait.
+         */
+        template<class F>
+        void run(F &&f) {
+            this->pending.fetch_add(1);
+            this->pool.submit([this, f = std::forward<F>(f)]() mutable {
+                // the task is done however f ends, so that wait never hangs on it.
+                // the group may be gone as soon as pending reaches 0,
+                // so only the pool is touched after that
+                struct Done {
+                    std::atomic<int> &pending;
+                    ThreadPool &pool;
+                    ~Done() {
+                        pending.fetch_sub(1, std::memory_order_release);
+                        pool.progressed();
+                    }
+                } done { this->pending, this->pool };
+                try {
+                    f();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(this->error_mutex);
+                    if (!this->error) {
+                        this->error = std::current_exception();
+                    }
+                }
+            }, this);
+        }
+
+        /**
+         * Run tasks of this group until every one of them is done.
+         *
+         * @throws whatever the first task of the group to throw threw.
+         */
+        void wait() {
+            this->finish();
+            std::exception_ptr thrown;
+            {
+                std::lock_guard<std::mutex> lock(this->error_mutex);
+                std::swap(thrown, this->error);
+            }
+            if (thrown) {
+                std::rethrow_exception(thrown);
+            }
+        }
+
+    private:
+        ThreadPool &pool;
+        std::atomic<int> pending = 0;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        // wait, without throwing, as the destructor has to
+        void finish() {
+            while (true) {
+                // read before looking at the queues, so that a task submitted
+                // or finished after that is sure to end the sleep below
+                const unsigned seen = this->pool.progress.load(std::memory_order_acquire);
+                if (this->pending.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+                if (!this->pool.run_one(this)) {
+                    this->pool.progress.wait(seen, std::memory_order_acquire);
+                }
+            }
+        }
+    };
+
+private:
+    struct Item {
+        Task task;
+        // the group the task is a part of, or nullptr
+        const TaskGroup *group;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Item> tasks;
+    };
+
+    // one per worker, all made before any worker starts
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    // the amount of tasks in all queues together
+    std::atomic<int> queued = 0;
+    // where tasks from outside of the pool go next
+    std::atomic<unsigned> next_queue = 0;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    // bumped whenever a task is submitted or a task of a group finishes,
+    // which is what threads waiting on a TaskGroup sleep on
+    std::atomic<unsigned> progress = 0;
+
+    void progressed() {
+        this->progress.fetch_add(1, std::memory_order_release);
+        this->progress.notify_all();
+    }
+
+    // which pool (if any) the current thread works for, and which worker it is
+    static inline thread_local ThreadPool *current_pool = nullptr;
+    static inline thread_local unsigned current_index = 0;
+
+    void submit(Task task, const TaskGroup *group) {
+        const unsigned i = current_pool == this
+            ? current_index
+            : this->next_queue.fetch_add(1, std::memory_order_relaxed) % this->size();
+        {
+            std::lock_guard<std::mutex> lock(this->queues[i]->mutex);
+            this->queues[i]->tasks.push_back(Item { std::move(task), group });
+            this->queued.fetch_add(1);
+        }
+        // taking the lock means no worker is between checking queued and sleeping
+        { std::lock_guard<std::mutex> lock(this->sleep_mutex); }
+        this->wake.notify_one();
+        this->progressed();
+    }
+
+    // run a queued task of `group` (or any task, if it is nullptr) on the calling thread
+    bool run_one(const TaskGroup *group) {
+        std::optional<Task> task = this->take(current_pool == this ? current_index : 0, group);
+        if (!task) {
+            return false;
+        }
+        (*task)();
+        return true;
+    }
+
+    // the newest task of queue `mine`, or else the oldest of any other queue,
+    // out of the tasks of `group` if it isn't nullptr
+    std::optional<Task> take(unsigned mine, const TaskGroup *group = nullptr) {
+        {
+            Queue &q = *this->queues[mine];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            for (auto it = q.tasks.rbegin(); it != q.tasks.rend(); ++it) {
+                if (group == nullptr || it->group == group) {
+                    Task t = std::move(it->task);
+                    q.tasks.erase(std::next(it).base());
+                    this->queued.fetch_sub(1);
+                    return t;
+                }
+            }
+        }
+        for (unsigned k = 1; k < this->size(); k++) {
+            Queue &q = *this->queues[(mine + k) % this->size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            for (auto it = q.tasks.begin(); it != q.tasks.end(); ++it) {
+                if (group == nullptr || it->group == group) {
+                    Task t = std::move(it->task);
+                    q.tasks.erase(it);
+                    this->queued.fetch_sub(1);
+                    return t;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    void work(unsigned index) {
+        current_pool = this;
+        current_index = index;
+        while (true) {
+            if (std::optional<Task> task = this->take(index)) {
+                (*task)();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(this->sleep_mutex);
+            this->wake.wait(lock, [this] {
+                return this->stopping || this->queued.load() > 0;
+            });
+            if (this->stopping && this->queued.load() == 0) {
+                return;
+            }
+        }
+    }
+};
+
+}
+
+#endif // !HEX_AI_UTIL_THREADPOOL_HPP
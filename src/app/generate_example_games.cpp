@@ -6,19 +6,28 @@
 
 #include <atomic>
 #include <cstdio>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <vector>
 
 #include "hex-ai/GameState/HexState.hpp"
 #include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameSolve/Budget.hpp"
 #include "hex-ai/GameSolve/HexUtil.hpp"
+#include "hex-ai/GameSolve/TranspositionTable.hpp"
 #include "hex-ai/GameState/enums.hpp"
 #include "hex-ai/Io/GamestateBool0.hpp"
+#include "hex-ai/Io/TranspositionTable0.hpp"
+#include "hex-ai/Util/ParseArg.hpp"
 
 using State = GameState::HexState<5>;
 using Action = GameState::Action;
@@ -48,37 +57,66 @@ int gen_winning(
     return 0;
 }
 
-/*
-int generate_examples(
+/**
+ * Makes n states with `stones` stones on them (fewer than a full board),
+ * none of which has a winner yet, solves who wins each with perfect play,
+ * and writes them down along with whether PLAYER_ONE does.
+ * Player one places the first stone, so it is their turn if `stones` is even.
+ * States that ab can't solve within `budget` are left out,
+ * so the file may have fewer than n states; `skipped` counts them.
+ * A state some other thread sharing ab's table has solved is found there
+ * instead of being solved again.
+ */
+int gen_solved(
     GameSolve::AlphaBeta2PlayersCached<5> &ab,
+    const GameSolve::Budget &budget,
     int n,
-    const std::string &output_path
+    int stones,
+    const std::string &output_path,
+    int &skipped
 ) {
     std::ofstream outfile(output_path);
     Io::GamestateBool0Writer<5> writer(outfile);
+    const GameState::PLAYERS mover = stones % 2 == 0 ? GameState::PLAYER_ONE : GameState::PLAYER_TWO;
     State s;
-    bool b;
-    
+    int err;
+
     // N times, create board state, solve it, and write down result.
     for (int x = 0; x < n; x++) {
         // make new game states until they don't have a winner
         do {
             s = State();
-            GameSolve::hex_rand_moves(s, 25, GameState::PLAYER_ONE);
+            GameSolve::hex_rand_moves(s, stones, GameState::PLAYER_ONE);
         } while (s.who_won() != GameState::PLAYER_NONE);
-        
-        // calculate outcome and write it down
-        b = ab.one_wins_one_turn(s);
-        if (writer.push(s, b)) {
-            throw std::exception();
+
+        // calculate outcome and write it down, if it can be had within the budget
+        const GameSolve::Verdict verdict = ab.solve_within(s, mover, budget);
+        if (!verdict.known()) {
+            skipped++;
+            continue;
+        }
+        if ((err = writer.push(s, verdict.winner == GameState::PLAYER_ONE))) {
+            return err;
         }
     }
 
     return 0;
 }
-*/
 
-void generate_loop(std::atomic<int> &count, int bundle, const std::string &filebase) {
+void generate_loop(
+    std::atomic<int> &count,
+    std::atomic<long> &total_skipped,
+    int bundle,
+    int stones,
+    GameSolve::TranspositionTable *table,
+    const GameSolve::Budget &budget,
+    const std::string &filebase
+) {
+    // full boards don't need solving, so then there is no table (and no solver)
+    std::optional<GameSolve::AlphaBeta2PlayersCached<5>> ab;
+    if (table != nullptr) {
+        ab.emplace(*table, true);
+    }
     while (true) {
         int my_count = count.fetch_sub(1);
         if (my_count <= 0) {
@@ -95,40 +133,106 @@ void generate_loop(std::atomic<int> &count, int bundle, const std::string &fileb
         s << filebase << "_bool" << std::setfill('0') << std::setw(5) << my_count;
         s >> bool_outs;
 
-        if (gen_winning(bundle, hex_outs)) {
+        int skipped = 0;
+        const int err = ab ? gen_solved(*ab, budget, bundle, stones, hex_outs, skipped) : gen_winning(bundle, hex_outs);
+        if (err) {
             std::cerr << "AAAAAAAAAAAAAAAAAA\n";
         }
-        std::cout << "finishing " << my_count << "\n";
+        total_skipped += skipped;
+        std::cout << "finishing " << my_count;
+        if (skipped) {
+            std::cout << " (" << skipped << " over budget, left out)";
+        }
+        std::cout << "\n";
     }
 }
 
 int main (int argc, char *argv[]) {
     if (argc < 5) {
-        std::cout << "needs 4 args\n";
+        std::cout << "needs 4 args (and optionally how many stones to place, 25 by default,\n"
+                     "and, for fewer, a file to start the solvers' table from and save it to after\n"
+                     "(or - for none) and the most nodes to search per state, 0 for no limit by default.\n"
+                     "States over that limit are left out, which leaves the files with fewer\n"
+                     "of the states that are hard to solve)\n";
         return 0;
     }
 
     std::atomic<int> count;
-    int thread_ct, bundle, int_count;
-    std::string filebase;
-
-    std::stringstream args;
-    args << argv[1] << ' ' << argv[2] << ' ' << argv[3] << ' ' << argv[4];
-    args >> thread_ct;
-    args >> int_count;
-    args >> bundle;
-    args >> filebase;
+    std::atomic<long> total_skipped = 0;
+    int thread_ct, bundle, int_count, stones = 25;
+    std::string filebase = argv[4], snapshot;
+
+    if (
+        !Util::parse_arg(argv[1], "the thread count", 1, 1024, thread_ct)
+        || !Util::parse_arg(argv[2], "the file count", 0, 99999, int_count)
+        || !Util::parse_arg(argv[3], "the states per file", 1, 1 << 30, bundle)
+        || (argc > 5 && !Util::parse_arg(argv[5], "the stone count", 0, 25, stones))
+    ) {
+        return 1;
+    }
+    if (argc > 6 && std::string(argv[6]) != "-") {
+        snapshot = argv[6];
+    }
+    // with a limit, states that would take longer than it to solve are left out
+    // rather than holding a thread up
+    GameSolve::Budget budget;
+    if (argc > 7 && !Util::parse_arg(argv[7], "the node limit", 0L, std::numeric_limits<long>::max(), budget.max_nodes)) {
+        return 1;
+    }
     count = int_count;
+    // if states need solving, one table for all the threads' solvers, so no two of them solve
+    // the same state (unless they get to it at the same time), which picks up where the last run
+    // left off if it can
+    std::unique_ptr<GameSolve::TranspositionTable> table;
+    if (stones < 25) {
+        if (!snapshot.empty()) {
+            Io::TranspositionTable0Reader reader(snapshot, 5, true);
+            table = reader.table();
+            if (table) {
+                std::cout << "starting from " << snapshot << "\n";
+            }
+        }
+        if (!table) {
+            table = std::make_unique<GameSolve::TranspositionTable>(1 << 22);
+        }
+    }
 
     std::vector<std::thread *> threads;
 
     for (int x = 0; x < thread_ct; x++) {
-        threads.push_back(new std::thread(generate_loop, std::ref(count), bundle, std::ref(filebase)));
+        threads.push_back(new std::thread(
+            generate_loop, std::ref(count), std::ref(total_skipped), bundle, stones, table.get(), std::cref(budget), std::ref(filebase)
+        ));
     }
 
     for (int x = 0; x < thread_ct; x++) {
         threads[x]->join();
     }
+    if (total_skipped > 0) {
+        std::cout << total_skipped << " states were over the node limit and left out\n";
+    }
+
+    if (table && !snapshot.empty()) {
+        // the table may still be mapped from the snapshot, so write a new file and move it over the old one
+        const std::string temp = snapshot + ".tmp";
+        std::ofstream outfile(temp, std::ofstream::binary);
+        Io::TranspositionTable0Writer writer(outfile, 5, true);
+        const bool failed = writer.write(*table);
+        outfile.close();
+        std::error_code ec;
+        if (failed || outfile.fail()) {
+            std::cerr << "could not save " << snapshot << "\n";
+            std::filesystem::remove(temp, ec);
+            return 1;
+        }
+        // the table is whole in temp by now, so keep it there if it can't be moved
+        std::filesystem::rename(temp, snapshot, ec);
+        if (ec) {
+            std::cerr << "could not move " << temp << " over " << snapshot << " (" << ec.message()
+                      << "), the table is left in " << temp << "\n";
+            return 1;
+        }
+    }
 
     return 0;
 }
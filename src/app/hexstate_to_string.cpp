@@ -10,13 +10,13 @@
 
 #include <cereal/archives/binary.hpp>
 
+#include "hex-ai/GameState/DynamicHexState.hpp"
 #include "hex-ai/GameState/HexState.hpp"
 #include "hex-ai/Io/io_enums.hpp"
 #include "hex-ai/Io/GamestateBool0.hpp"
 #include "hex-ai/GameSolve/AlphaBeta.hpp"
 
 using std::string;
-using State = GameState::HexState<5>;
 using Io::GamestateBool0Reader;
 
 int main (int argc, char *argv[]) {
@@ -59,23 +59,26 @@ int main (int argc, char *argv[]) {
         std::cerr << "hex-ai: File " << argv[1] << " is not of GAMESTATE_BOOL version equal to 0.\n";
         return 1;
     }
-    if (board_size != 5) {
-        std::cerr << "hex-ai: File " << argv[1] << " does not contain boards of size 5x5.\n";
+    if (!GameState::dynamic_bsize(board_size)) {
+        std::cerr << "hex-ai: File " << argv[1] << " contains boards of unsupported size "
+                  << +board_size << ".\n";
         return 1;
     }
 
-    State h;
-    bool b;
-    GamestateBool0Reader<5> reader(infile);
+    return GameState::with_bsize(board_size, [&](auto size) {
+        GameState::HexState<size> h;
+        bool b;
+        GamestateBool0Reader<size> reader(infile);
 
-    while (reader.read_err() != GamestateBool0Reader<5>::EMPTY) {
-        if (reader.pop(h, b) != GamestateBool0Reader<5>::CLEAR) {
-            std::cerr << "hex-ai: File " << argv[1] << " was corrupted and could not be read.\n";
-            return 1;
+        while (reader.read_err() != GamestateBool0Reader<size>::EMPTY) {
+            if (reader.pop(h, b) != GamestateBool0Reader<size>::CLEAR) {
+                std::cerr << "hex-ai: File " << argv[1] << " was corrupted and could not be read.\n";
+                return 1;
+            }
+            h.simple_string(py_states);
+            py_bools << (b ? '1' : '0') << '\n';
         }
-        h.simple_string(py_states);
-        py_bools << (b ? '1' : '0') << '\n';
-    }
-    return 0;
+        return 0;
+    });
 }
 
@@ -16,8 +16,11 @@
 #include <cereal/archives/binary.hpp>
 #include <cereal/details/helpers.hpp>
 
+#include "hex-ai/GameState/DynamicHexState.hpp"
 #include "hex-ai/GameState/HexState.hpp"
 #include "hex-ai/Io/GamestateBool0.hpp"
+#include "hex-ai/Io/SolvedDatabase0.hpp"
+#include "hex-ai/Io/TranspositionTable0.hpp"
 #include "hex-ai/Io/io_enums.hpp"
 
 /**
@@ -38,32 +41,32 @@ void info_file(const std::string &filename) {
                 case Io::GAMESTATE_BOOL:
                     switch (version) {
                         case 0:
-                            {
+                            if (!GameState::dynamic_bsize(board_size)) {
+                                std::cerr << "hex-ai: "
+                                          << filename
+                                          << " has unreadable board size "
+                                          << +board_size << std::endl;
+                                break;
+                            }
+                            GameState::with_bsize(board_size, [&](auto size) {
+                                using Reader = Io::GamestateBool0Reader<size>;
                                 int acc = 0;
-                                GameState::HexState<5> state;
+                                GameState::HexState<size> state;
                                 bool b;
-                                // TODO: this is disgusting - fix it
-                                if (board_size == 5) {
-                                    Io::GamestateBool0Reader<5> r(infile);
-                                    while (r.pop(state, b) == Io::GamestateBool0Reader<5>::CLEAR) {
-                                        ++acc;
-                                    }
-                                    if (r.read_err() != Io::GamestateBool0Reader<5>::EMPTY) {
-                                        std::cerr << "hex-ai: "
-                                                  << filename
-                                                  << " contained an error.\n";
-                                    } else {
-                                        std::cout << filename 
-                                                << ": GAMESTATE_BOOL version 0, "
-                                                << acc << std::endl;
-                                    }
-                                } else {
+                                Reader r(infile);
+                                while (r.pop(state, b) == Reader::CLEAR) {
+                                    ++acc;
+                                }
+                                if (r.read_err() != Reader::EMPTY) {
                                     std::cerr << "hex-ai: "
                                               << filename
-                                              << " has unreadable board size "
-                                              << board_size << std::endl;
+                                              << " contained an error.\n";
+                                } else {
+                                    std::cout << filename 
+                                            << ": GAMESTATE_BOOL version 0, "
+                                            << acc << std::endl;
                                 }
-                            }
+                            });
                             break;
                         default:
                             // couldn't find version
@@ -71,6 +74,56 @@ void info_file(const std::string &filename) {
                             break;
                     }
                     break;
+                case Io::SOLVED_DATABASE:
+                    if (version != 0) {
+                        std::cerr << "hex-ai: " << filename << " has bad version\n";
+                        break;
+                    }
+                    if (!GameState::dynamic_bsize(board_size) || board_size > 5) {
+                        std::cerr << "hex-ai: "
+                                  << filename
+                                  << " has unreadable board size "
+                                  << +board_size << std::endl;
+                        break;
+                    }
+                    GameState::with_bsize(board_size, [&](auto size) {
+                        if constexpr (size <= 5) {
+                            Io::SolvedDatabase0Reader<size> r(filename);
+                            if (r.read_err() != Io::SolvedDatabase0Reader<size>::CLEAR) {
+                                std::cerr << "hex-ai: "
+                                          << filename
+                                          << " contained an error.\n";
+                            } else {
+                                std::cout << filename
+                                        << ": SOLVED_DATABASE version 0, "
+                                        << r.size() << std::endl;
+                            }
+                        }
+                    });
+                    break;
+                case Io::TRANSPOSITION_TABLE: {
+                    if (version != 0) {
+                        std::cerr << "hex-ai: " << filename << " has bad version\n";
+                        break;
+                    }
+                    // the byte after the board size says whether the table used symmetry
+                    uint8_t use_symmetry;
+                    arc(use_symmetry);
+                    Io::TranspositionTable0Reader r(filename, board_size, use_symmetry != 0);
+                    if (r.read_err() != Io::TranspositionTable0Reader::CLEAR) {
+                        std::cerr << "hex-ai: "
+                                  << filename
+                                  << " contained an error ("
+                                  << r.read_err() << ").\n";
+                    } else {
+                        std::cout << filename
+                                << ": TRANSPOSITION_TABLE version 0, board size "
+                                << +board_size
+                                << (use_symmetry ? ", with symmetry, " : ", without symmetry, ")
+                                << r.size() << std::endl;
+                    }
+                    break;
+                }
                 default:
                     // couldn't find file type
                     std::cerr << "hex-ai: " << filename << " has bad file type\n";
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "hex-ai/GameSolve/HexUtil.hpp"
+#include "hex-ai/GameSolve/ParallelSolver.hpp"
+#include "hex-ai/GameState/DynamicHexState.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Util/ThreadPool.hpp"
+
+int main (int argc, char *argv[]) {
+    if (argc < 4) {
+        std::cerr << "usage: parallel_scaling <board size> <states> <stones> [max threads] [split depth]\n"
+                  << "Solves the same random states (with `stones` stones, none of them won yet)\n"
+                  << "with a ParallelSolver on 1, 2, 4 and so on threads, up to max threads\n"
+                  << "(default: every core), and prints how long each took and how much faster\n"
+                  << "than one thread that was. Every run starts from an empty table.\n"
+                  << "6x6 from about 8 stones takes a few seconds a state on one thread.\n";
+        return 1;
+    }
+
+    int board_size, states, stones, split_depth = 1;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    std::stringstream args;
+    args << argv[1];
+    for (int i = 2; i < argc; i++) {
+        args << ' ' << argv[i];
+    }
+    args >> board_size >> states >> stones;
+    args >> max_threads;
+    args >> split_depth;
+    if (!GameState::dynamic_bsize(board_size) || board_size < 3 || board_size > 7) {
+        std::cerr << "hex-ai: parallel_scaling solves boards of size 3 to 7, not " << board_size << ".\n";
+        return 1;
+    }
+    max_threads = std::max(max_threads, 1u);
+
+    return GameState::with_bsize(board_size, [&](auto size) {
+        if constexpr (size >= 3 && size <= 7) {
+            using State = GameState::HexState<size>;
+
+            std::vector<State> positions;
+            while (static_cast<int>(positions.size()) < states) {
+                State s;
+                GameSolve::hex_rand_moves(s, stones, GameState::PLAYER_ONE);
+                if (s.who_won() == GameState::PLAYER_NONE) {
+                    positions.push_back(s);
+                }
+            }
+
+            std::vector<unsigned> counts;
+            for (unsigned t = 1; t < max_threads; t *= 2) {
+                counts.push_back(t);
+            }
+            counts.push_back(max_threads);
+
+            double one_thread = 0;
+            int one_wins = -1;
+            std::cout << "threads     seconds   speedup       nodes\n";
+            for (const unsigned threads : counts) {
+                Util::ThreadPool pool(threads);
+                GameSolve::ParallelSolver<size> solver(pool, 1 << 22);
+                int wins = 0;
+                const auto start = std::chrono::steady_clock::now();
+                for (const State &s : positions) {
+                    wins += stones % 2 == 0 ? solver.one_wins_one_turn(s) : solver.one_wins_two_turn(s);
+                }
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (threads == 1) {
+                    one_thread = seconds;
+                    one_wins = wins;
+                }
+                std::cout << std::setw(7) << threads
+                          << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+                          << std::setw(10) << std::setprecision(2) << one_thread / seconds
+                          << std::setw(12) << solver.nodes_expanded.load() << "\n";
+                // every run has to agree on who wins, or the speedup means nothing
+                if (wins != one_wins) {
+                    std::cerr << "hex-ai: " << threads << " threads found player one winning "
+                              << wins << " states, but one thread found " << one_wins << ".\n";
+                    return 1;
+                }
+            }
+            return 0;
+        } else {
+            return 1;
+        }
+    });
+}
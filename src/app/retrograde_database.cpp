@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "hex-ai/GameSolve/Retrograde.hpp"
+#include "hex-ai/GameState/DynamicHexState.hpp"
+#include "hex-ai/Io/SolvedDatabase0.hpp"
+#include "hex-ai/Util/ParseArg.hpp"
+#include "hex-ai/Util/ThreadPool.hpp"
+
+// the fewest stones a 5x5 board can be solved from without --force (see RetrogradeSolver)
+constexpr int min_5x5_ply = 21;
+
+int main (int argc, char *argv[]) {
+    // --force can go anywhere after the output file
+    bool force = false;
+    std::vector<const char *> args;
+    for (int i = 1; i < argc; i++) {
+        if (i > 2 && std::string_view(argv[i]) == "--force") {
+            force = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (args.size() < 2 || args.size() > 4) {
+        std::cerr << "usage: retrograde_database <board size> <output file> [min stones] [threads] [--force]\n"
+                  << "Solves every state of a normal game with at least min stones (default 0)\n"
+                  << "on the board at once, working back from the full boards, and writes\n"
+                  << "the ones nobody has won yet out as a SolvedDatabase file.\n"
+                  << "Boards of up to 4x4 can be done from the start. 5x5 from 22 stones takes\n"
+                  << "about 300 MB of memory and writes a 3 GB file, from 21 stones about 850 MB\n"
+                  << "and a 13 GB file, and needs as much free space again for temporary files.\n"
+                  << "5x5 from fewer than " << min_5x5_ply << " stones needs --force.\n";
+        return 1;
+    }
+
+    int board_size, min_ply = 0;
+    unsigned threads = std::max(std::thread::hardware_concurrency(), 1u);
+    // a 1x1 board is won by the first move, so there is nothing to keep
+    if (!Util::parse_arg(args[0], "the board size", 2, 5, board_size)
+        || (args.size() > 2 && !Util::parse_arg(args[2], "the min stones", 0, board_size * board_size, min_ply))
+        || (args.size() > 3 && !Util::parse_arg(args[3], "the thread count", 1u, 1024u, threads))) {
+        return 1;
+    }
+    if (board_size == 5 && min_ply < min_5x5_ply && !force) {
+        std::cerr << "hex-ai: solving 5x5 from " << min_ply << " stones takes far more memory than from "
+                  << min_5x5_ply << " (about 20 GB from the start); give --force to do it anyway.\n";
+        return 1;
+    }
+
+    std::ofstream outfile(args[1], std::ofstream::binary);
+    if (!outfile) {
+        std::cerr << "hex-ai: File " << args[1] << " could not be opened for writing.\n";
+        return 1;
+    }
+
+    return GameState::with_bsize(board_size, [&](auto size) {
+        if constexpr (size >= 2 && size <= 5) {
+            Util::ThreadPool pool(threads);
+            GameSolve::RetrogradeSolver<size> solver(pool, min_ply);
+            solver.solve();
+
+            Io::SolvedDatabase0Writer<size> writer(outfile);
+            solver.write(writer);
+            if (writer.finish() != Io::SolvedDatabase0Writer<size>::CLEAR) {
+                std::cerr << "hex-ai: File " << args[1] << " could not be written to.\n";
+                return 1;
+            }
+            return 0;
+        } else {
+            return 1;
+        }
+    });
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <bit>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameSolve/Retrograde.hpp"
+#include "hex-ai/GameState/DynamicHexState.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Io/SolvedDatabase0.hpp"
+#include "hex-ai/Util/ParseArg.hpp"
+
+/**
+ * Visited is a bit for every state that can be reached from some first state,
+ * set once that state is done. States are numbered like they are
+ * in GameSolve::RetrogradeSolver, but only by the cells that were empty
+ * in the first state, so that the bits only cover states that can come up,
+ * which is about 3^(empty cells) of them.
+ */
+template<int bsize>
+class Visited {
+public:
+    using Ranks = GameSolve::RetrogradeSolver<bsize>;
+
+    /**
+     * @param first the state everything to be visited is reached from.
+     * @param mover the player to move in `first`.
+     */
+    Visited(const GameState::HexState<bsize> &first, GameState::PLAYERS mover)
+        : first_ones(first.stones_of(GameState::PLAYER_ONE).word(0)),
+          first_twos(first.stones_of(GameState::PLAYER_TWO).word(0)),
+          free(~(first_ones | first_twos) & ((uint64_t(1) << bsize * bsize) - 1)),
+          one_first(mover == GameState::PLAYER_ONE) {
+        const int empty = std::popcount(this->free);
+        this->offsets.push_back(0);
+        for (int added = 0; added <= empty; added++) {
+            this->offsets.push_back(
+                this->offsets.back() + Ranks::binomial(empty, added) * Ranks::binomial(added, this->ones_added(added))
+            );
+        }
+        this->bits.assign((this->offsets.back() + 63) / 64, 0);
+    }
+
+    /**
+     * Mark `state` as visited, along with its rotation if that can be reached too.
+     *
+     * @param state a state reached from the first state.
+     * @return whether it (or its rotation) wasn't visited already.
+     */
+    bool insert(const GameState::HexState<bsize> &state) {
+        const auto &one = state.stones_of(GameState::PLAYER_ONE);
+        const auto &two = state.stones_of(GameState::PLAYER_TWO);
+        if (!this->mark(one.word(0), two.word(0))) {
+            return false;
+        }
+        const uint64_t rotated_ones = one.reversed().word(0), rotated_twos = two.reversed().word(0);
+        if ((rotated_ones & this->first_ones) == this->first_ones
+            && (rotated_twos & this->first_twos) == this->first_twos) {
+            this->mark(rotated_ones, rotated_twos);
+        }
+        return true;
+    }
+
+private:
+    uint64_t first_ones, first_twos;
+    // the cells that were empty in the first state
+    uint64_t free;
+    bool one_first;
+    // offsets[n] is the number of the first state with n more stones than the first state
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> bits;
+
+    // how many of `added` stones after the first state are player one's
+    int ones_added(int added) const {
+        return this->one_first ? (added + 1) / 2 : added / 2;
+    }
+
+    // set the bit of the state, and say whether it wasn't set
+    bool mark(uint64_t ones, uint64_t twos) {
+        const uint64_t added = Ranks::squeeze(ones | twos, this->free);
+        const int count = std::popcount(added);
+        const uint64_t i = this->offsets[count]
+            + Ranks::rank(added) * Ranks::binomial(count, this->ones_added(count))
+            + Ranks::rank(Ranks::squeeze(Ranks::squeeze(ones, this->free), added));
+        const uint64_t bit = uint64_t(1) << (i & 63);
+        const bool fresh = !(this->bits[i >> 6] & bit);
+        this->bits[i >> 6] |= bit;
+        return fresh;
+    }
+};
+
+/**
+ * Solve every state that can be reached from `state` which nobody has won yet,
+ * and push it to `writer`. The states after a state are solved before it,
+ * so that solving it mostly comes down to looking them up in the cache of `ab`.
+ *
+ * @param state the state to start from, left as it was found.
+ * @param mover the player to move in `state`.
+ * @param ab the solver to solve states with.
+ * @param seen every state done so far.
+ * @param writer where to put the solved states.
+ */
+template<int bsize>
+void solve_reachable(
+    GameState::HexState<bsize> &state,
+    GameState::PLAYERS mover,
+    GameSolve::AlphaBeta2PlayersCached<bsize> &ab,
+    Visited<bsize> &seen,
+    Io::SolvedDatabase0Writer<bsize> &writer
+) {
+    if (state.who_won() != GameState::PLAYER_NONE || !seen.insert(state)) {
+        return;
+    }
+
+    const GameState::PLAYERS next =
+        mover == GameState::PLAYER_ONE ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+    const auto empty = state.empty_cells();
+    for (int c = empty.next(); c < bsize * bsize; c = empty.next(c + 1)) {
+        state.succeed(GameState::PackedAction(c, mover));
+        solve_reachable(state, next, ab, seen, writer);
+        state.succeed(GameState::PackedAction(c, GameState::PLAYER_NONE));
+    }
+
+    writer.push(
+        state,
+        mover == GameState::PLAYER_ONE ? ab.one_wins_one_turn(state) : ab.one_wins_two_turn(state)
+    );
+}
+
+int main (int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: solve_database <board size> <output file> [cell ...]\n"
+                  << "Solves every state reachable from the state after the given cells\n"
+                  << "are played (player one first, then taking turns), and writes\n"
+                  << "them out as a SolvedDatabase file. Boards of up to 4x4 can be\n"
+                  << "done from the start, 5x5 only from a state well into the game.\n";
+        return 1;
+    }
+
+    int board_size;
+    // a 1x1 board is won by the first move, so there is nothing to keep
+    if (!Util::parse_arg(argv[1], "the board size", 2, 5, board_size)) {
+        return 1;
+    }
+    std::vector<int> moves;
+    for (int i = 3; i < argc; i++) {
+        int cell;
+        if (!Util::parse_arg(argv[i], "a cell", 0, board_size * board_size - 1, cell)) {
+            return 1;
+        }
+        moves.push_back(cell);
+    }
+
+    std::ofstream outfile(argv[2], std::ofstream::binary);
+    if (!outfile) {
+        std::cerr << "hex-ai: File " << argv[2] << " could not be opened for writing.\n";
+        return 1;
+    }
+
+    return GameState::with_bsize(board_size, [&](auto size) {
+        if constexpr (size >= 2 && size <= 5) {
+            GameState::HexState<size> state;
+            GameState::PLAYERS mover = GameState::PLAYER_ONE;
+            for (int cell : moves) {
+                if (state.at(cell / size, cell % size) != GameState::PLAYER_NONE) {
+                    std::cerr << "hex-ai: " << cell << " is not an empty cell.\n";
+                    return 1;
+                }
+                state.succeed(GameState::PackedAction(cell, mover));
+                mover = mover == GameState::PLAYER_ONE ? GameState::PLAYER_TWO : GameState::PLAYER_ONE;
+            }
+
+            GameSolve::AlphaBeta2PlayersCached<size> ab(1 << 22);
+            Visited<size> seen(state, mover);
+            Io::SolvedDatabase0Writer<size> writer(outfile);
+            solve_reachable<size>(state, mover, ab, seen, writer);
+            if (writer.finish() != Io::SolvedDatabase0Writer<size>::CLEAR) {
+                std::cerr << "hex-ai: File " << argv[2] << " could not be written to.\n";
+                return 1;
+            }
+            std::cout << "wrote " << writer.size() << " states to " << argv[2] << "\n";
+            return 0;
+        } else {
+            return 1;
+        }
+    });
+}
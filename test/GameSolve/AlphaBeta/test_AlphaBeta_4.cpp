@@ -0,0 +1,362 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <chrono>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameSolve/Budget.hpp"
+#include "hex-ai/GameSolve/Cancel.hpp"
+#include "hex-ai/GameSolve/SolveResult.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+#include "../RandomState.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(test_AlphaBeta_4, symmetry_agrees) {
+    std::mt19937 rng(4);
+    GameSolve::AlphaBeta2PlayersCached<4> plain {1 << 16};
+    GameSolve::AlphaBeta2PlayersCached<4> symmetric {1 << 16, true};
+
+    for (int trial = 0; trial < 40; trial++) {
+        // an even amount of stones, so it is player one's turn
+        GameState::HexState<4> state = random_state<4>(rng, 6);
+        GameState::HexState<4> rotated = state;
+        rotated.flip(GameState::BOTH);
+
+        const bool expected = plain.one_wins_one_turn(state);
+        EXPECT_EQ(symmetric.one_wins_one_turn(state), expected)
+            << "Solving with symmetry gave a different answer.\n";
+        EXPECT_EQ(symmetric.one_wins_one_turn(rotated), expected)
+            << "Rotated board had a different answer.\n";
+    }
+}
+
+TEST(test_AlphaBeta_4, symmetry_saves_nodes) {
+    // raster order and no pruning, so that only the symmetry differs
+    const GameSolve::MoveOrdering<4> raster(GameSolve::ORDER_NONE);
+    GameSolve::AlphaBeta2PlayersCached<4> plain {1 << 20, false, raster, false};
+    GameSolve::AlphaBeta2PlayersCached<4> symmetric {1 << 20, true, raster, false};
+    GameState::HexState<4> state;
+    // (a position whose search runs into a rotation of something it has already solved)
+    state.succeed(Action(0, 1, PLAYER_ONE));
+    state.succeed(Action(1, 2, PLAYER_TWO));
+
+    EXPECT_EQ(plain.one_wins_one_turn(state), symmetric.one_wins_one_turn(state));
+    EXPECT_LT(symmetric.nodes_expanded, plain.nodes_expanded)
+        << "Keying the cache on symmetry did not save any work.\n";
+}
+
+TEST(test_AlphaBeta_4, ordering_agrees) {
+    std::mt19937 rng(14);
+
+    for (int trial = 0; trial < 20; trial++) {
+        GameSolve::AlphaBeta2PlayersCached<4> raster {1 << 16, false, GameSolve::MoveOrdering<4>(GameSolve::ORDER_NONE), false};
+        GameSolve::AlphaBeta2PlayersCached<4> ordered {1 << 16, false, GameSolve::MoveOrdering<4>(), false};
+        GameState::HexState<4> state = random_state<4>(rng, 4);
+
+        EXPECT_EQ(ordered.one_wins_one_turn(state), raster.one_wins_one_turn(state))
+            << "Ordering the moves gave a different answer.\n";
+        EXPECT_LE(ordered.nodes_expanded, raster.nodes_expanded)
+            << "Ordering the moves expanded more nodes.\n";
+    }
+}
+
+TEST(test_AlphaBeta_4, best_move) {
+    std::mt19937 rng(15);
+    GameSolve::AlphaBeta2PlayersCached<4> symmetric {1 << 16, true};
+    GameSolve::AlphaBeta2PlayersCached<4> check {1 << 16};
+
+    for (int trial = 0; trial < 20; trial++) {
+        GameState::HexState<4> state = random_state<4>(rng, 6);
+        if (state.who_won() != PLAYER_NONE || !symmetric.one_wins_one_turn(state)) {
+            continue;
+        }
+
+        const std::optional<GameState::PackedAction> best = symmetric.best_move(state);
+        ASSERT_TRUE(best.has_value()) << "A won state had no winning move.\n";
+        EXPECT_EQ(best->whose(), PLAYER_ONE);
+        EXPECT_EQ(state.at(best->cell() / 4, best->cell() % 4), PLAYER_NONE);
+        state.succeed(*best);
+        EXPECT_TRUE(check.one_wins_two_turn(state)) << "The best move did not win.\n";
+    }
+}
+
+TEST(test_AlphaBeta_4, pruning_agrees) {
+    std::mt19937 rng(16);
+    long pruned_nodes = 0, plain_nodes = 0;
+
+    for (int trial = 0; trial < 40; trial++) {
+        GameSolve::AlphaBeta2PlayersCached<4> plain {1 << 16, false, GameSolve::MoveOrdering<4>(), false};
+        GameSolve::AlphaBeta2PlayersCached<4> pruned {1 << 16};
+        GameState::HexState<4> state = random_state<4>(rng, 6);
+
+        EXPECT_EQ(pruned.one_wins_one_turn(state), plain.one_wins_one_turn(state))
+            << "Skipping inferior moves gave a different answer.\n";
+        pruned_nodes += pruned.nodes_expanded;
+        plain_nodes += plain.nodes_expanded;
+    }
+    EXPECT_LT(pruned_nodes, plain_nodes) << "Skipping inferior moves did not save any work.\n";
+}
+
+TEST(test_AlphaBeta_4, solve_win_in_one) {
+    GameSolve::AlphaBeta2PlayersCached<4> ab {1 << 16};
+    GameState::HexState<4> state;
+    for (int y = 0; y < 3; y++) {
+        state.succeed(Action(1, y, PLAYER_ONE));
+        state.succeed(Action(3, y, PLAYER_TWO));
+    }
+
+    const GameSolve::SolveResult result = ab.solve(state, PLAYER_ONE);
+    EXPECT_EQ(result.winner, PLAYER_ONE);
+    EXPECT_EQ(result.plies, 1);
+    ASSERT_TRUE(result.move.has_value());
+    ASSERT_EQ(result.pv.size(), 1);
+    EXPECT_EQ(result.pv[0], *result.move);
+
+    state.succeed(*result.move);
+    EXPECT_EQ(state.who_won(), PLAYER_ONE) << "The winning move did not win.\n";
+    const GameSolve::SolveResult won = ab.solve(state, PLAYER_TWO);
+    EXPECT_EQ(won.winner, PLAYER_ONE);
+    EXPECT_EQ(won.plies, 0);
+    EXPECT_TRUE(won.pv.empty());
+    EXPECT_FALSE(won.move.has_value()) << "A finished game had a move.\n";
+}
+
+TEST(test_AlphaBeta_4, solve_lines) {
+    std::mt19937 rng(17);
+
+    for (int trial = 0; trial < 20; trial++) {
+        GameState::HexState<4> state = random_state<4>(rng, 5);
+        if (state.who_won() != PLAYER_NONE) {
+            continue;
+        }
+        GameSolve::AlphaBeta2PlayersCached<4> ab {1 << 16};
+        GameSolve::AlphaBeta2PlayersCached<4> check {1 << 16};
+        const GameState::HexState<4> before = state;
+
+        const GameSolve::SolveResult result = ab.solve(state, PLAYER_TWO);
+        EXPECT_EQ(state, before) << "Solving changed the state.\n";
+        EXPECT_EQ(result.winner == PLAYER_ONE, check.one_wins_two_turn(state))
+            << "solve and one_wins_two_turn disagree.\n";
+        EXPECT_EQ(result.move.has_value(), result.winner == PLAYER_TWO);
+        EXPECT_EQ(result.plies % 2, result.winner == PLAYER_TWO ? 1 : 0);
+
+        // playing out the principal variation takes exactly `plies` moves
+        ASSERT_EQ(static_cast<int>(result.pv.size()), result.plies);
+        for (size_t i = 0; i < result.pv.size(); i++) {
+            EXPECT_EQ(state.who_won(), PLAYER_NONE) << "The game was over before the line was.\n";
+            EXPECT_EQ(result.pv[i].whose(), i % 2 ? PLAYER_ONE : PLAYER_TWO);
+            state.succeed(result.pv[i]);
+        }
+        EXPECT_EQ(state.who_won(), result.winner) << "The line did not end in a win.\n";
+    }
+}
+
+// the least amount of moves in which the winner can force a win,
+// negative if the player to move loses, by looking at every line
+static int quickest_win(GameState::HexState<3> &state, GameState::PLAYERS mover) {
+    const GameState::PLAYERS next = mover == PLAYER_ONE ? PLAYER_TWO : PLAYER_ONE;
+    int best_win = 0, longest_loss = 0;
+    for (int c = 0; c < 9; c++) {
+        if (state.at(c / 3, c % 3) != PLAYER_NONE) {
+            continue;
+        }
+        state.succeed(Action(c / 3, c % 3, mover));
+        const int child = state.who_won() == mover ? 0 : quickest_win(state, next);
+        state.succeed(Action(c / 3, c % 3, PLAYER_NONE));
+        if (child <= 0 && (best_win == 0 || 1 - child < best_win)) {
+            best_win = 1 - child;
+        } else if (child > 0 && -(child + 1) < longest_loss) {
+            longest_loss = -(child + 1);
+        }
+    }
+    return best_win > 0 ? best_win : longest_loss;
+}
+
+TEST(test_AlphaBeta_4, solve_is_quickest) {
+    std::mt19937 rng(18);
+
+    for (int trial = 0; trial < 30; trial++) {
+        GameState::HexState<3> state = random_state<3>(rng, 2);
+        GameSolve::AlphaBeta2PlayersCached<3> ab {1 << 12};
+
+        const GameSolve::SolveResult result = ab.solve(state, PLAYER_ONE);
+        const int expected = quickest_win(state, PLAYER_ONE);
+        EXPECT_EQ(result.winner, expected > 0 ? PLAYER_ONE : PLAYER_TWO);
+        EXPECT_EQ(result.plies, expected > 0 ? expected : -expected)
+            << "The win found was not the quickest.\n";
+        EXPECT_EQ(static_cast<int>(result.pv.size()), result.plies);
+    }
+}
+
+TEST(test_AlphaBeta_4, solve_again_costs_nothing) {
+    std::mt19937 rng(19);
+
+    for (int trial = 0; trial < 20; trial++) {
+        GameState::HexState<4> state = random_state<4>(rng, 4);
+        if (state.who_won() != PLAYER_NONE) {
+            continue;
+        }
+        GameSolve::AlphaBeta2PlayersCached<4> ab {1 << 16};
+
+        const GameSolve::SolveResult result = ab.solve(state, PLAYER_ONE);
+        ASSERT_GT(result.plies, 0);
+
+        // a state still in the table is read straight back out of it
+        const long nodes = ab.nodes_expanded;
+        const GameSolve::SolveResult again = ab.solve(state, PLAYER_ONE);
+        EXPECT_EQ(ab.nodes_expanded, nodes);
+        EXPECT_EQ(again.plies, result.plies);
+        EXPECT_EQ(again.pv, result.pv);
+    }
+}
+
+TEST(test_AlphaBeta_4, solve_runs_out_while_timing) {
+    // enough budget to find out who wins, but not how quickly
+    GameState::HexState<4> state;
+    state.succeed(Action(1, 1, PLAYER_ONE));
+    state.succeed(Action(2, 2, PLAYER_TWO));
+    GameSolve::AlphaBeta2PlayersCached<4> check {1 << 16};
+    const bool one_wins = check.one_wins_one_turn(state);
+
+    GameSolve::AlphaBeta2PlayersCached<4> ab {1 << 16};
+    GameSolve::Budget budget;
+    budget.max_nodes = check.nodes_expanded + 1;
+    const GameSolve::SolveResult result = ab.solve(state, PLAYER_ONE, budget);
+    EXPECT_EQ(result.winner, one_wins ? PLAYER_ONE : PLAYER_TWO);
+    EXPECT_EQ(result.plies, -1);
+    EXPECT_TRUE(result.pv.empty());
+    EXPECT_EQ(result.move.has_value(), one_wins);
+    EXPECT_EQ(ab.nodes_expanded, budget.max_nodes);
+}
+
+TEST(test_AlphaBeta_4, solve_tries_the_known_move) {
+    // the quickest win is looked for starting from the winning move the table already has
+    std::mt19937 rng(20);
+    long with_hint = 0, without_hint = 0;
+
+    for (int trial = 0; trial < 10; trial++) {
+        GameState::HexState<5> state = random_state<5>(rng, 8);
+        if (state.who_won() != PLAYER_NONE) {
+            continue;
+        }
+        GameSolve::AlphaBeta2PlayersCached<5> hinted {1 << 20};
+        GameSolve::AlphaBeta2PlayersCached<5> plain {
+            1 << 20, false, GameSolve::MoveOrdering<5>(GameSolve::ORDER_ALL & ~GameSolve::ORDER_CACHE_MOVE)
+        };
+        const GameSolve::SolveResult result = hinted.solve(state, PLAYER_ONE);
+        EXPECT_EQ(plain.solve(state, PLAYER_ONE).plies, result.plies);
+        with_hint += hinted.nodes_expanded;
+        without_hint += plain.nodes_expanded;
+    }
+    EXPECT_LT(with_hint, without_hint) << "Trying the known winning move first did not save any work.\n";
+}
+
+TEST(test_AlphaBeta_4, big_boards) {
+    // the solver works on the largest boards too, even if it only can solve states near the end there
+    GameSolve::AlphaBeta2PlayersCached<19> ab {1 << 10};
+    GameState::HexState<19> state;
+    for (int y = 0; y < 18; y++) {
+        state.succeed(Action(1, y, PLAYER_ONE));
+        state.succeed(Action(3, y, PLAYER_TWO));
+    }
+    const GameSolve::SolveResult result = ab.solve(state, PLAYER_ONE);
+    EXPECT_EQ(result.winner, PLAYER_ONE);
+    EXPECT_EQ(result.plies, 1);
+    ASSERT_TRUE(result.move.has_value());
+    state.succeed(*result.move);
+    EXPECT_EQ(state.who_won(), PLAYER_ONE) << "The winning move did not win.\n";
+}
+
+TEST(test_AlphaBeta_4, solve_runs_out_of_budget) {
+    GameSolve::AlphaBeta2PlayersCached<4> ab {1 << 16};
+    GameState::HexState<4> state;
+    GameSolve::Budget budget;
+    budget.max_nodes = 10;
+
+    const GameSolve::SolveResult result = ab.solve(state, PLAYER_ONE, budget);
+    EXPECT_EQ(result.winner, PLAYER_NONE) << "A solve over budget still gave an answer.\n";
+    EXPECT_TRUE(result.pv.empty());
+    EXPECT_FALSE(result.move.has_value());
+    EXPECT_EQ(ab.nodes_expanded, 10);
+}
+
+TEST(test_AlphaBeta_4, budget_runs_out) {
+    // an ordering that learns nothing, so that only the cache differs between the two
+    const GameSolve::MoveOrdering<4> centre(GameSolve::ORDER_CENTRE);
+    GameSolve::AlphaBeta2PlayersCached<4> ab {1 << 16, false, centre};
+    GameSolve::AlphaBeta2PlayersCached<4> check {1 << 16, false, centre};
+    GameState::HexState<4> state;
+    state.succeed(Action(0, 0, PLAYER_ONE));
+    state.succeed(Action(3, 3, PLAYER_TWO));
+    const GameState::HexState<4> before = state;
+
+    GameSolve::Budget budget;
+    budget.max_nodes = 100;
+    const GameSolve::Verdict verdict = ab.solve_within(state, PLAYER_ONE, budget);
+    EXPECT_FALSE(verdict.known()) << "A search over budget still gave an answer.\n";
+    EXPECT_EQ(verdict.stats.nodes_expanded, 100);
+    EXPECT_GT(verdict.stats.max_depth, 0);
+    EXPECT_EQ(state, before);
+
+    // nothing unfinished was kept, so more budget gives the right answer
+    const bool expected = check.one_wins_one_turn(state);
+    budget.max_nodes = 0;
+    const GameSolve::Verdict again = ab.solve_within(state, PLAYER_ONE, budget);
+    ASSERT_TRUE(again.known());
+    EXPECT_EQ(again.winner, expected ? PLAYER_ONE : PLAYER_TWO);
+    EXPECT_LT(again.stats.nodes_expanded, check.nodes_expanded)
+        << "Trying again did not reuse the finished part of the first search.\n";
+    EXPECT_EQ(ab.one_wins_one_turn(state), expected);
+}
+
+TEST(test_AlphaBeta_4, budget_time_and_cancel) {
+    GameSolve::AlphaBeta2PlayersCached<5> ab {1 << 16};
+    GameState::HexState<5> state;
+
+    GameSolve::Budget budget;
+    budget.max_time = std::chrono::nanoseconds(1);
+    EXPECT_FALSE(ab.solve_within(state, PLAYER_ONE, budget).known())
+        << "An empty 5x5 board was solved in a nanosecond.\n";
+
+    GameSolve::Cancel cancel;
+    cancel.cancel();
+    budget.max_time = std::chrono::steady_clock::duration::zero();
+    budget.cancel = &cancel;
+    const GameSolve::Verdict verdict = ab.solve_within(state, PLAYER_TWO, budget);
+    EXPECT_FALSE(verdict.known()) << "A cancelled search still gave an answer.\n";
+    EXPECT_EQ(verdict.stats.nodes_expanded, 0);
+    EXPECT_EQ(state, GameState::HexState<5>());
+}
+
+TEST(test_AlphaBeta_4, budget_enough) {
+    std::mt19937 rng(18);
+
+    for (int trial = 0; trial < 20; trial++) {
+        GameSolve::AlphaBeta2PlayersCached<4> plain {1 << 16};
+        GameSolve::AlphaBeta2PlayersCached<4> budgeted {1 << 16};
+        GameState::HexState<4> state = random_state<4>(rng, 5);
+
+        GameSolve::Budget budget;
+        budget.max_nodes = 1 << 20;
+        budget.max_time = std::chrono::minutes(1);
+        const GameSolve::Verdict verdict = budgeted.solve_within(state, PLAYER_TWO, budget);
+        ASSERT_TRUE(verdict.known());
+        EXPECT_EQ(verdict.winner, plain.one_wins_two_turn(state) ? PLAYER_ONE : PLAYER_TWO);
+        EXPECT_EQ(verdict.stats.nodes_expanded, plain.nodes_expanded);
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameSolve/Dfpn.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+#include "../RandomState.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(test_Dfpn, already_won) {
+    GameSolve::DfpnSolver<1> dfpn {16};
+    GameState::HexState<1> one, two;
+    one.succeed({0, 0, PLAYER_ONE});
+    two.succeed({0, 0, PLAYER_TWO});
+
+    EXPECT_TRUE(dfpn.one_wins_one_turn(one));
+    EXPECT_TRUE(dfpn.one_wins_two_turn(one));
+    EXPECT_FALSE(dfpn.one_wins_one_turn(two));
+    EXPECT_FALSE(dfpn.one_wins_two_turn(two));
+}
+
+TEST(test_Dfpn, first_player_wins_empty_board) {
+    GameSolve::DfpnSolver<1> dfpn1 {1 << 10};
+    GameSolve::DfpnSolver<2> dfpn2 {1 << 10};
+    GameSolve::DfpnSolver<3> dfpn3 {1 << 12};
+    GameSolve::DfpnSolver<4> dfpn4 {1 << 16};
+    GameState::HexState<1> s1;
+    GameState::HexState<2> s2;
+    GameState::HexState<3> s3;
+    GameState::HexState<4> s4;
+
+    EXPECT_TRUE(dfpn1.one_wins_one_turn(s1));
+    EXPECT_TRUE(dfpn2.one_wins_one_turn(s2));
+    EXPECT_TRUE(dfpn3.one_wins_one_turn(s3));
+    EXPECT_TRUE(dfpn4.one_wins_one_turn(s4));
+    // and so whoever goes first wins, even if it is player two
+    EXPECT_FALSE(dfpn4.one_wins_two_turn(s4));
+    EXPECT_EQ(s4, GameState::HexState<4>())
+        << "State was changed by DfpnSolver.\n";
+}
+
+TEST(test_Dfpn, agrees_with_alpha_beta_4) {
+    std::mt19937 rng(12);
+    // AlphaBeta2PlayersCached keys its cache on the stones alone,
+    // so it needs one cache per player to move
+    GameSolve::AlphaBeta2PlayersCached<4> ab1 {1 << 16};
+    GameSolve::AlphaBeta2PlayersCached<4> ab2 {1 << 16};
+    GameSolve::DfpnSolver<4> dfpn {1 << 16};
+
+    for (int trial = 0; trial < 60; trial++) {
+        GameState::HexState<4> state = random_state<4>(rng, 4 + 2 * (trial % 3));
+        const GameState::HexState<4> before = state;
+        EXPECT_EQ(dfpn.one_wins_one_turn(state), ab1.one_wins_one_turn(state))
+            << "Solvers disagreed with player one to move.\n";
+        EXPECT_EQ(dfpn.one_wins_two_turn(state), ab2.one_wins_two_turn(state))
+            << "Solvers disagreed with player two to move.\n";
+        EXPECT_EQ(state, before)
+            << "State was changed by DfpnSolver.\n";
+    }
+}
+
+TEST(test_Dfpn, agrees_with_alpha_beta_5) {
+    std::mt19937 rng(13);
+    GameSolve::AlphaBeta2PlayersCached<5> ab {1 << 18};
+    GameSolve::DfpnSolver<5> dfpn {1 << 18};
+
+    for (int trial = 0; trial < 20; trial++) {
+        GameState::HexState<5> state = random_state<5>(rng, 14);
+        EXPECT_EQ(dfpn.one_wins_one_turn(state), ab.one_wins_one_turn(state))
+            << "Solvers disagreed with player one to move.\n";
+    }
+}
+
+TEST(test_Dfpn, tiny_table) {
+    // a table with room for hardly anything still gives the right answers
+    std::mt19937 rng(14);
+    GameSolve::AlphaBeta2PlayersCached<4> ab {1 << 16};
+    GameSolve::DfpnSolver<4> dfpn {64};
+
+    for (int trial = 0; trial < 20; trial++) {
+        GameState::HexState<4> state = random_state<4>(rng, 6);
+        EXPECT_EQ(dfpn.one_wins_one_turn(state), ab.one_wins_one_turn(state));
+    }
+}
+
+TEST(test_Dfpn, cancelled) {
+    GameSolve::DfpnSolver<5> dfpn {1 << 12};
+    GameSolve::Cancel parent;
+    GameSolve::Cancel child(&parent);
+    GameState::HexState<5> state;
+
+    parent.cancel();
+    EXPECT_TRUE(child.cancelled());
+    EXPECT_FALSE(dfpn.mover_wins(state, PLAYER_ONE, &child).has_value())
+        << "A cancelled search still gave an answer.\n";
+    EXPECT_EQ(state, GameState::HexState<5>());
+}
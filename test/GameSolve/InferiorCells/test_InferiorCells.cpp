@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/InferiorCells.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+#include "../RandomState.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(test_InferiorCells, empty_board) {
+    GameState::HexState<5> state;
+    EXPECT_TRUE(GameSolve::InferiorCells<5>::dead(state).none())
+        << "An empty board had dead cells.\n";
+    EXPECT_TRUE(GameSolve::InferiorCells<5>::captured(state, PLAYER_ONE).none())
+        << "An empty board had captured cells.\n";
+}
+
+TEST(test_InferiorCells, dead) {
+    GameState::HexState<5> state;
+    // four stones in a row around (2, 2)
+    state.succeed(Action(3, 2, PLAYER_ONE));
+    state.succeed(Action(2, 3, PLAYER_ONE));
+    state.succeed(Action(1, 3, PLAYER_ONE));
+    state.succeed(Action(1, 2, PLAYER_ONE));
+
+    EXPECT_TRUE(GameSolve::InferiorCells<5>::dead(state).test(12))
+        << "A cell with four of one player's stones in a row around it was not dead.\n";
+    EXPECT_FALSE(GameSolve::InferiorCells<5>::dead(state).test(11))
+        << "A cell next to the stones was dead.\n";
+}
+
+TEST(test_InferiorCells, captured) {
+    GameState::HexState<5> state;
+    // (2, 1) has two ways to P1's edge, (2, 0) and (3, 0)
+    state.succeed(Action(2, 1, PLAYER_ONE));
+
+    const auto mine = GameSolve::InferiorCells<5>::captured(state, PLAYER_ONE);
+    EXPECT_TRUE(mine.test(10) && mine.test(15))
+        << "The cells between a stone and its edge were not captured.\n";
+    EXPECT_EQ(mine.count(), 2);
+    EXPECT_TRUE(GameSolve::InferiorCells<5>::captured(state, PLAYER_TWO).none())
+        << "P2 captured cells next to nothing of theirs.\n";
+
+    const auto inferior = GameSolve::InferiorCells<5>::inferior_moves(state, PLAYER_TWO);
+    EXPECT_TRUE(inferior.test(10) && inferior.test(15))
+        << "Moves into captured cells were not inferior.\n";
+}
+
+TEST(test_InferiorCells, keeps_a_move) {
+    std::mt19937 rng(16);
+
+    for (int trial = 0; trial < 200; trial++) {
+        const int stones = rng() % 16;
+        GameState::HexState<4> state = random_state<4>(rng, stones);
+        if (state.who_won() != PLAYER_NONE) {
+            continue;
+        }
+
+        const auto inferior = GameSolve::InferiorCells<4>::inferior_moves(state, PLAYER_ONE);
+        EXPECT_TRUE((inferior & ~state.empty_cells()).none())
+            << "A cell with a stone in it was inferior.\n";
+        EXPECT_NE(inferior, state.empty_cells())
+            << "Every move was inferior.\n";
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/MoveOrdering.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(test_MoveOrdering, every_empty_cell_once) {
+    GameState::HexState<5> state;
+    state.succeed(Action(2, 2, PLAYER_ONE));
+    state.succeed(Action(0, 4, PLAYER_TWO));
+
+    for (unsigned h : { GameSolve::ORDER_NONE, GameSolve::ORDER_ALL }) {
+        GameSolve::MoveOrdering<5> ordering(h);
+        GameSolve::MoveOrdering<5>::Moves moves;
+        const int count = ordering.order(state, PLAYER_ONE, -1, moves);
+        ASSERT_EQ(count, 23);
+        std::sort(moves.begin(), moves.begin() + count);
+        for (int i = 0, c = 0; c < 25; c++) {
+            if (c != 12 && c != 4) {
+                EXPECT_EQ(moves[i++], c) << "Cell " << c << " was not listed once.\n";
+            }
+        }
+    }
+}
+
+TEST(test_MoveOrdering, raster_and_centre) {
+    GameState::HexState<5> state;
+    GameSolve::MoveOrdering<5>::Moves moves;
+
+    GameSolve::MoveOrdering<5> raster(GameSolve::ORDER_NONE);
+    raster.order(state, PLAYER_ONE, -1, moves);
+    for (int c = 0; c < 25; c++) {
+        EXPECT_EQ(moves[c], c) << "Moves were not in raster order.\n";
+    }
+
+    GameSolve::MoveOrdering<5> centre(GameSolve::ORDER_CENTRE);
+    centre.order(state, PLAYER_ONE, -1, moves);
+    EXPECT_EQ(moves[0], 12) << "The middle of the board was not tried first.\n";
+}
+
+TEST(test_MoveOrdering, hint_then_killers) {
+    GameState::HexState<5> state;
+    GameSolve::MoveOrdering<5> ordering;
+    GameSolve::MoveOrdering<5>::Moves moves;
+
+    ordering.cutoff(state, PLAYER_ONE, 3);
+    ordering.cutoff(state, PLAYER_ONE, 20);
+    ordering.order(state, PLAYER_ONE, 0, moves);
+    EXPECT_EQ(moves[0], 0) << "The cached move was not tried first.\n";
+    EXPECT_EQ(moves[1], 20) << "The newest killer move was not tried next.\n";
+    EXPECT_EQ(moves[2], 3) << "The older killer move was not tried next.\n";
+}
+
+TEST(test_MoveOrdering, history) {
+    GameState::HexState<5> state;
+    GameSolve::MoveOrdering<5> ordering;
+    GameSolve::MoveOrdering<5>::Moves moves;
+
+    ordering.cutoff(state, PLAYER_ONE, 3);
+    // killers belong to a depth, but history scores count everywhere
+    state.succeed(Action(2, 2, PLAYER_ONE));
+    ordering.order(state, PLAYER_ONE, -1, moves);
+    EXPECT_EQ(moves[0], 3) << "A move with a history score was not tried first.\n";
+    ordering.order(state, PLAYER_TWO, -1, moves);
+    EXPECT_EQ(moves[0], 7) << "Player two used player one's history.\n";
+
+    ordering.clear();
+    ordering.order(state, PLAYER_ONE, -1, moves);
+    EXPECT_EQ(moves[0], 7) << "Clearing did not forget the history.\n";
+}
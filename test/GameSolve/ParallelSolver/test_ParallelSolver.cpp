@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/Dfpn.hpp"
+#include "hex-ai/GameSolve/ParallelSolver.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Util/ThreadPool.hpp"
+
+#include "../RandomState.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(test_ParallelSolver, already_won) {
+    Util::ThreadPool pool(2);
+    GameSolve::ParallelSolver<2> solver {pool, 64};
+    GameState::HexState<2> one;
+    one.succeed({0, 0, PLAYER_ONE});
+    one.succeed({0, 1, PLAYER_ONE});
+
+    EXPECT_TRUE(solver.one_wins_one_turn(one));
+    EXPECT_TRUE(solver.one_wins_two_turn(one));
+}
+
+TEST(test_ParallelSolver, agrees_with_dfpn) {
+    std::mt19937 rng(15);
+    for (unsigned threads : { 1u, 4u }) {
+        for (int split_depth : { 0, 1, 2 }) {
+            Util::ThreadPool pool(threads);
+            GameSolve::ParallelSolver<5> parallel {pool, 1 << 16, split_depth};
+            GameSolve::DfpnSolver<5> dfpn {1 << 16};
+
+            for (int trial = 0; trial < 10; trial++) {
+                GameState::HexState<5> state = random_state<5>(rng, 8 + 2 * (trial % 3));
+                EXPECT_EQ(parallel.one_wins_one_turn(state), dfpn.one_wins_one_turn(state))
+                    << "Solvers disagreed with " << threads << " threads"
+                    << " splitting " << split_depth << " deep.\n";
+                EXPECT_EQ(parallel.one_wins_two_turn(state), dfpn.one_wins_two_turn(state))
+                    << "Solvers disagreed with " << threads << " threads"
+                    << " splitting " << split_depth << " deep.\n";
+            }
+        }
+    }
+}
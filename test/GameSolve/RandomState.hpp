@@ -0,0 +1,36 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HEX_AI_TEST_GAMESOLVE_RANDOMSTATE_HPP
+#define HEX_AI_TEST_GAMESOLVE_RANDOMSTATE_HPP
+
+#include <random>
+
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+/**
+ * @return a board with `stones` stones placed on random empty cells,
+ *         player one's first and the players taking turns,
+ *         so that it is player one's turn if `stones` is even
+ *         (someone may have won already, though).
+ */
+template<int bsize>
+GameState::HexState<bsize> random_state(std::mt19937 &rng, int stones) {
+    GameState::HexState<bsize> state;
+    for (int placed = 0; placed < stones;) {
+        const int cell = rng() % (bsize * bsize);
+        if (state.at(cell / bsize, cell % bsize) == GameState::PLAYER_NONE) {
+            state.succeed(GameState::Action(
+                cell / bsize, cell % bsize, placed++ % 2 ? GameState::PLAYER_TWO : GameState::PLAYER_ONE
+            ));
+        }
+    }
+    return state;
+}
+
+#endif // !HEX_AI_TEST_GAMESOLVE_RANDOMSTATE_HPP
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameSolve/Retrograde.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Io/SolvedDatabase0.hpp"
+#include "hex-ai/Util/ThreadPool.hpp"
+
+#include "../RandomState.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(test_Retrograde, indexes) {
+    using Solver = GameSolve::RetrogradeSolver<3>;
+    // every way to colour a 3x3 board where player one has as many stones or one more
+    std::vector<std::vector<bool>> used(10);
+    for (int ply = 0; ply <= 9; ply++) {
+        used[ply].assign(Solver::ply_size(ply), false);
+    }
+    for (int colouring = 0; colouring < 19683; colouring++) {
+        uint64_t ones = 0, twos = 0;
+        for (int c = 0, rest = colouring; c < 9; c++, rest /= 3) {
+            ones |= uint64_t(rest % 3 == 1) << c;
+            twos |= uint64_t(rest % 3 == 2) << c;
+        }
+        const int n1 = std::popcount(ones), n2 = std::popcount(twos);
+        if (n1 != n2 && n1 != n2 + 1) {
+            continue;
+        }
+        const uint64_t index = Solver::index_of(ones, twos);
+        ASSERT_LT(index, Solver::ply_size(n1 + n2));
+        EXPECT_FALSE(used[n1 + n2][index]) << "Two states had the same index.\n";
+        used[n1 + n2][index] = true;
+    }
+    for (int ply = 0; ply <= 9; ply++) {
+        EXPECT_EQ(std::count(used[ply].begin(), used[ply].end(), false), 0)
+            << "An index of ply " << ply << " had no state.\n";
+    }
+}
+
+TEST(test_Retrograde, agrees_with_alpha_beta) {
+    Util::ThreadPool pool(2);
+    GameSolve::RetrogradeSolver<3> three(pool);
+    three.solve();
+    // and the end of 4x4 games, which still takes a few sweeps
+    GameSolve::RetrogradeSolver<4> four(pool, 12);
+    four.solve();
+    std::mt19937 rng(20);
+
+    for (int trial = 0; trial < 200; trial++) {
+        const int stones3 = rng() % 9, stones4 = 12 + rng() % 4;
+        GameState::HexState<3> state3 = random_state<3>(rng, stones3);
+        GameState::HexState<4> state4 = random_state<4>(rng, stones4);
+        const auto mover3 = stones3 % 2 ? PLAYER_TWO : PLAYER_ONE;
+        const auto mover4 = stones4 % 2 ? PLAYER_TWO : PLAYER_ONE;
+
+        GameSolve::AlphaBeta2PlayersCached<3> ab3 {1 << 10};
+        GameSolve::AlphaBeta2PlayersCached<4> ab4 {1 << 12};
+        EXPECT_EQ(three.one_wins(state3, mover3),
+                  mover3 == PLAYER_ONE ? ab3.one_wins_one_turn(state3) : ab3.one_wins_two_turn(state3));
+        EXPECT_EQ(four.one_wins(state4, mover4),
+                  mover4 == PLAYER_ONE ? ab4.one_wins_one_turn(state4) : ab4.one_wins_two_turn(state4));
+        EXPECT_FALSE(three.one_wins(state3, mover3 == PLAYER_ONE ? PLAYER_TWO : PLAYER_ONE).has_value())
+            << "A state was answered with the wrong player to move.\n";
+    }
+
+    EXPECT_FALSE(four.one_wins(random_state<4>(rng, 11), PLAYER_TWO).has_value())
+        << "A ply that was never solved was answered.\n";
+}
+
+TEST(test_Retrograde, writes_database) {
+    Util::ThreadPool pool(1);
+    GameSolve::RetrogradeSolver<3> solver(pool);
+    solver.solve();
+    const std::string path = (std::filesystem::temp_directory_path() / "test_Retrograde_3.db").string();
+    {
+        std::ofstream out(path, std::ofstream::binary);
+        Io::SolvedDatabase0Writer<3> writer(out);
+        solver.write(writer);
+        ASSERT_EQ(writer.finish(), Io::SolvedDatabase0Writer<3>::CLEAR);
+    }
+
+    Io::SolvedDatabase0Reader<3> reader(path);
+    ASSERT_EQ(reader.read_err(), Io::SolvedDatabase0Reader<3>::CLEAR);
+    // every state of a 3x3 game nobody has won yet, up to rotation
+    EXPECT_EQ(reader.size(), 2278);
+    std::mt19937 rng(20);
+    for (int trial = 0; trial < 200; trial++) {
+        const int stones = rng() % 9;
+        GameState::HexState<3> state = random_state<3>(rng, stones);
+        const auto mover = stones % 2 ? PLAYER_TWO : PLAYER_ONE;
+        if (state.who_won() == PLAYER_NONE) {
+            EXPECT_EQ(reader.one_wins(state, mover), solver.one_wins(state, mover));
+        } else {
+            EXPECT_FALSE(reader.one_wins(state, mover).has_value()) << "A won state was written.\n";
+        }
+    }
+
+    std::filesystem::remove(path);
+}
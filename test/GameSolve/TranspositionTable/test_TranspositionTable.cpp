@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameSolve/TranspositionTable.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+#include "../RandomState.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+// a key that lands in the first bucket of any table, told apart by `tag`
+static uint64_t key_in_first_bucket(uint64_t tag) {
+    return tag << 28;
+}
+
+TEST(test_TranspositionTable, store_and_probe) {
+    GameSolve::TranspositionTable table(1 << 10);
+    EXPECT_EQ(table.capacity(), 1 << 10);
+    EXPECT_FALSE(table.probe(12345).has_value()) << "An empty table had an entry.\n";
+
+    table.store(12345, 42, 3);
+    EXPECT_EQ(table.probe(12345), std::optional<uint16_t>(42));
+    table.store(12345, 7, 1);
+    EXPECT_EQ(table.probe(12345), std::optional<uint16_t>(7)) << "A key was not stored over.\n";
+    // the same bucket, but a different tag
+    EXPECT_FALSE(table.probe(12345 + (uint64_t(1) << 40)).has_value());
+
+    // the key of an empty board is 0
+    table.store(0, 0, 0);
+    EXPECT_EQ(table.probe(0), std::optional<uint16_t>(0)) << "The key 0 was not stored.\n";
+
+    table.clear();
+    EXPECT_FALSE(table.probe(12345).has_value()) << "A cleared table had an entry.\n";
+}
+
+TEST(test_TranspositionTable, replacement) {
+    // a single bucket of 8 entries
+    GameSolve::TranspositionTable table(8);
+    for (uint64_t tag = 1; tag <= 8; tag++) {
+        table.store(key_in_first_bucket(tag), static_cast<uint16_t>(tag), static_cast<int>(tag));
+    }
+    for (uint64_t tag = 1; tag <= 8; tag++) {
+        EXPECT_TRUE(table.probe(key_in_first_bucket(tag)).has_value()) << "A full bucket lost an entry.\n";
+    }
+
+    // the shallowest entry makes room
+    table.store(key_in_first_bucket(9), 9, 5);
+    EXPECT_FALSE(table.probe(key_in_first_bucket(1)).has_value())
+        << "The shallowest entry was not the one replaced.\n";
+    EXPECT_TRUE(table.probe(key_in_first_bucket(2)).has_value());
+
+    // a few generations on, deep entries that went unused lose out to one that was
+    for (int i = 0; i < 3; i++) {
+        table.new_generation();
+    }
+    EXPECT_TRUE(table.probe(key_in_first_bucket(2)).has_value());
+    table.store(key_in_first_bucket(10), 10, 0);
+    EXPECT_TRUE(table.probe(key_in_first_bucket(2)).has_value())
+        << "An entry that was just used was replaced.\n";
+    EXPECT_FALSE(table.probe(key_in_first_bucket(3)).has_value())
+        << "The entry worth the least was not the one replaced.\n";
+}
+
+TEST(test_TranspositionTable, threads) {
+    // every thread stores and probes the same keys, each with data made from its key,
+    // so any entry torn between two stores would show up as the wrong data
+    GameSolve::TranspositionTable table(1 << 8);
+    std::vector<uint64_t> keys(1 << 12);
+    std::mt19937_64 rng(21);
+    for (uint64_t &key : keys) {
+        key = rng();
+    }
+    auto data_of = [](uint64_t key) { return static_cast<uint16_t>(key % 4096); };
+
+    std::vector<std::thread> threads;
+    std::vector<int> wrong(4, 0);
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            for (int round = 0; round < 20; round++) {
+                for (size_t i = t; i < keys.size(); i += 3) {
+                    table.store(keys[i], data_of(keys[i]), round % 8);
+                    const std::optional<uint16_t> found = table.probe(keys[(i * 7) % keys.size()]);
+                    wrong[t] += found && *found != data_of(keys[(i * 7) % keys.size()]);
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (int t = 0; t < 4; t++) {
+        EXPECT_EQ(wrong[t], 0) << "A probe found data stored for another key.\n";
+    }
+}
+
+TEST(test_TranspositionTable, shared_by_solvers) {
+    GameSolve::TranspositionTable table(1 << 16);
+    std::mt19937 rng(21);
+    std::vector<GameState::HexState<4>> states;
+    while (states.size() < 8) {
+        GameState::HexState<4> state = random_state<4>(rng, 4);
+        states.push_back(state);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<bool>> answers(2, std::vector<bool>(states.size()));
+    for (int t = 0; t < 2; t++) {
+        threads.emplace_back([&, t] {
+            GameSolve::AlphaBeta2PlayersCached<4> ab {table};
+            for (size_t i = 0; i < states.size(); i++) {
+                GameState::HexState<4> state = states[i];
+                answers[t][i] = ab.one_wins_one_turn(state);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < states.size(); i++) {
+        GameSolve::AlphaBeta2PlayersCached<4> alone {1 << 16};
+        const bool expected = alone.one_wins_one_turn(states[i]);
+        EXPECT_EQ(answers[0][i], expected) << "Sharing a table gave a different answer.\n";
+        EXPECT_EQ(answers[1][i], expected) << "Sharing a table gave a different answer.\n";
+    }
+}
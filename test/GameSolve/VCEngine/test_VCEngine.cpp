@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/VCEngine.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+using GameState::Action;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+template<int bsize>
+static typename GameState::HexState<bsize>::Board board_of(std::initializer_list<int> cells) {
+    typename GameState::HexState<bsize>::Board b;
+    for (int c : cells) {
+        b.set(c);
+    }
+    return b;
+}
+
+TEST(test_VCEngine, bridge) {
+    GameSolve::VCEngine<4> vc;
+    GameState::HexState<4> state;
+    // (1, 1) and (2, 2) share the empty neighbours (2, 1) and (1, 2)
+    state.succeed(Action(1, 1, PLAYER_ONE));
+    state.succeed(Action(2, 2, PLAYER_ONE));
+
+    vc.compute(state, PLAYER_ONE);
+    const int a = vc.point_of(5), b = vc.point_of(10);
+    ASSERT_NE(a, b);
+    bool found = false;
+    for (const auto &carrier : vc.full(a, b)) {
+        found |= carrier == board_of<4>({ 6, 9 });
+    }
+    EXPECT_TRUE(found) << "The bridge was not found.\n";
+
+    // taking one of its cells leaves it a semi connection through the other
+    state.succeed(Action(1, 2, PLAYER_TWO));
+    vc.compute(state, PLAYER_ONE);
+    EXPECT_TRUE(vc.full(a, b).empty()) << "A broken bridge was still fully connected.\n";
+    found = false;
+    for (const auto &carrier : vc.semi(a, b)) {
+        found |= carrier == board_of<4>({ 9 });
+    }
+    EXPECT_TRUE(found) << "The broken bridge was not a semi connection.\n";
+}
+
+TEST(test_VCEngine, edge_templates) {
+    GameSolve::VCEngine<3> vc;
+    GameState::HexState<3> state;
+    // the middle of a 3x3 board is two edge templates from both edges
+    state.succeed(Action(1, 1, PLAYER_ONE));
+    vc.compute(state, PLAYER_ONE);
+    EXPECT_TRUE(vc.connected()) << "The middle stone did not connect P1's edges.\n";
+    vc.compute(state, PLAYER_TWO);
+    EXPECT_FALSE(vc.connected()) << "P2 was connected through P1's stone.\n";
+    EXPECT_FALSE(vc.semi_connected()) << "P2 was semi connected through P1's stone.\n";
+
+    // with (1, 0) gone, P2 can stop P1 at (2, 0) or in the other template
+    state.succeed(Action(1, 0, PLAYER_TWO));
+    vc.compute(state, PLAYER_ONE);
+    EXPECT_FALSE(vc.connected());
+    EXPECT_TRUE(vc.semi_connected()) << "P1 was not semi connected.\n";
+    EXPECT_EQ(vc.mustplay(), board_of<3>({ 2, 5, 6 })) << "The wrong cells were mustplay.\n";
+}
+
+TEST(test_VCEngine, empty_five) {
+    GameSolve::VCEngine<5> vc;
+    GameState::HexState<5> state;
+    // the middle stone joins both edges with templates that don't overlap
+    vc.compute(state, PLAYER_ONE);
+    EXPECT_TRUE(vc.semi_connected()) << "5x5 was not semi connected from the start.\n";
+    EXPECT_TRUE(vc.mustplay().test(12)) << "The middle was not mustplay.\n";
+}
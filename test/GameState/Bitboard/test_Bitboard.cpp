@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameState/Bitboard.hpp"
+
+using GameState::Bitboard;
+
+TEST(Bitboard_25, empty) {
+    Bitboard<25> b;
+
+    EXPECT_TRUE(b.none());
+    EXPECT_FALSE(b.any());
+    EXPECT_EQ(b.count(), 0);
+    EXPECT_EQ(b.next(), 25)
+        << "Empty board had a set bit.\n";
+}
+
+TEST(Bitboard_25, set_reset) {
+    Bitboard<25> b;
+    b.set(0).set(7).set(24);
+
+    EXPECT_TRUE(b.test(0));
+    EXPECT_TRUE(b.test(7));
+    EXPECT_TRUE(b.test(24));
+    EXPECT_FALSE(b.test(8));
+    EXPECT_EQ(b.count(), 3);
+
+    b.reset(7);
+    EXPECT_FALSE(b.test(7));
+    EXPECT_EQ(b.count(), 2);
+}
+
+TEST(Bitboard_25, complement_stays_in_range) {
+    Bitboard<25> b;
+    b.set(3);
+
+    EXPECT_EQ((~b).count(), 24)
+        << "Complement set bits outside of the board.\n";
+    EXPECT_EQ(~~b, b);
+    EXPECT_EQ(Bitboard<25>::full().count(), 25);
+}
+
+TEST(Bitboard_25, iterate) {
+    Bitboard<25> b;
+    b.set(2).set(3).set(19);
+    int expected[3] = { 2, 3, 19 }, found = 0;
+
+    for (int i = b.next(); i < 25; i = b.next(i + 1)) {
+        ASSERT_LT(found, 3);
+        EXPECT_EQ(i, expected[found++]);
+    }
+    EXPECT_EQ(found, 3);
+}
+
+TEST(Bitboard_121, multiword) {
+    Bitboard<121> a, b;
+    a.set(0).set(63).set(64).set(120);
+    b.set(63).set(100);
+
+    EXPECT_EQ(Bitboard<121>::words, 2);
+    EXPECT_EQ(a.count(), 4);
+    EXPECT_EQ((a & b).count(), 1);
+    EXPECT_TRUE((a & b).test(63));
+    EXPECT_EQ((a | b).count(), 5);
+    EXPECT_EQ((a ^ b).count(), 4);
+    EXPECT_EQ((~a).count(), 117);
+    EXPECT_EQ(a.next(1), 63);
+    EXPECT_EQ(a.next(64), 64);
+    EXPECT_EQ(a.next(65), 120);
+    EXPECT_EQ(a.next(121), 121);
+    EXPECT_NE(a, b);
+}
+
+TEST(Bitboard_121, runs_of_bits) {
+    Bitboard<121> a;
+    a.set_bits(60, 11, 0x7ff);
+
+    EXPECT_EQ(a.count(), 11);
+    EXPECT_TRUE(a.test(60));
+    EXPECT_TRUE(a.test(70));
+    EXPECT_FALSE(a.test(71));
+    EXPECT_EQ(a.bits_at(60, 11), 0x7ffu);
+    EXPECT_EQ(a.bits_at(58, 4), 0xcu);
+    EXPECT_EQ(a.bits_at(57, 64), uint64_t(0x7ff) << 3);
+
+    // only the lowest n bits of a run are used
+    a.set_bits(110, 3, ~uint64_t(0));
+    EXPECT_EQ(a.count(), 14);
+    EXPECT_EQ(a.bits_at(109, 5), 0xeu);
+}
+
+TEST(Bitboard_121, shift_and_reverse) {
+    Bitboard<121> a;
+    a.set(0).set(63).set(120);
+
+    EXPECT_EQ(a << 1, Bitboard<121>().set(1).set(64));
+    EXPECT_EQ(a >> 1, Bitboard<121>().set(62).set(119));
+    EXPECT_EQ(a.reversed(), Bitboard<121>().set(0).set(57).set(120));
+    EXPECT_EQ(a.reversed().reversed(), a);
+}
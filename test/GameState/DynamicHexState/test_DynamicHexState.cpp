@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <cereal/cereal.hpp>
+
+#include "cereal/archives/binary.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/DynamicHexState.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+using GameState::Action;
+using GameState::DynamicHexState;
+using GameState::HexState;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(DynamicHexState, with_bsize) {
+    for (int n = GameState::MIN_DYNAMIC_BSIZE; n <= GameState::MAX_DYNAMIC_BSIZE; n++) {
+        const int cells = GameState::with_bsize(n, [](auto size) {
+            return HexState<size>::cells;
+        });
+        EXPECT_EQ(cells, n * n)
+            << "with_bsize(" << n << ") chose the wrong size.\n";
+    }
+
+    EXPECT_FALSE(GameState::dynamic_bsize(0));
+    EXPECT_TRUE(GameState::dynamic_bsize(1));
+    EXPECT_TRUE(GameState::dynamic_bsize(19));
+    EXPECT_FALSE(GameState::dynamic_bsize(20));
+}
+
+TEST(DynamicHexState, empty) {
+    for (int n = GameState::MIN_DYNAMIC_BSIZE; n <= GameState::MAX_DYNAMIC_BSIZE; n++) {
+        DynamicHexState state(n);
+        std::vector<Action> actions;
+        state.get_actions(actions, PLAYER_ONE);
+
+        EXPECT_EQ(state.bsize(), n);
+        EXPECT_EQ(state.who_won(), PLAYER_NONE);
+        EXPECT_EQ(actions.size(), size_t(n * n));
+    }
+}
+
+TEST(DynamicHexState, succeed_and_win) {
+    DynamicHexState state(7);
+    for (int x = 0; x < 7; x++) {
+        EXPECT_EQ(state.who_won(), PLAYER_NONE);
+        state.succeed(Action(x, 3, PLAYER_TWO));
+    }
+    EXPECT_EQ(state.who_won(), PLAYER_TWO);
+
+    // the same game on the HexState underneath, which is only ever 7x7,
+    // though visit instantiates this for every size (and (6, 3) is off the smaller boards)
+    state.visit([](auto &s) {
+        if constexpr (std::remove_cvref_t<decltype(s)>::cells == 7 * 7) {
+            EXPECT_EQ(s.at(6, 3), PLAYER_TWO);
+            s.succeed(Action(6, 3, PLAYER_NONE));
+        } else {
+            FAIL() << "A 7x7 DynamicHexState held another size of board.\n";
+        }
+    });
+    EXPECT_EQ(state.who_won(), PLAYER_NONE);
+}
+
+TEST(DynamicHexState, cereal) {
+    HexState<11> original;
+    original.succeed(Action(0, 10, PLAYER_ONE));
+    original.succeed(Action(5, 5, PLAYER_TWO));
+    original.succeed(Action(10, 0, PLAYER_ONE));
+
+    std::stringstream s;
+    {
+        cereal::BinaryOutputArchive arc(s);
+        arc(original);
+    }
+    DynamicHexState read(11);
+    {
+        cereal::BinaryInputArchive arc(s);
+        arc(read);
+    }
+
+    read.visit([&](const auto &r) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(r)>, HexState<11>>) {
+            EXPECT_EQ(r, original);
+        } else {
+            ADD_FAILURE() << "DynamicHexState(11) did not hold a HexState<11>.\n";
+        }
+    });
+
+    std::stringstream expected, actual;
+    original.simple_string(expected);
+    read.simple_string(actual);
+    EXPECT_EQ(actual.str(), expected.str());
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/FloodFill.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+using GameState::Action;
+using GameState::FloodFill;
+using GameState::HexState;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+TEST(FloodFill_5, grow_corner_and_middle) {
+    using Board = FloodFill<5>::Board;
+    Board b;
+
+    // (0, 0) touches (1, 0) and (0, 1) only
+    b.set(0);
+    EXPECT_EQ(FloodFill<5>::grow(b), Board().set(0).set(5).set(1))
+        << "Corner cell grew to the wrong cells.\n";
+
+    // (2, 2) touches all six of its neighbours
+    b = Board().set(12);
+    Board expected;
+    expected.set(12).set(17).set(7).set(13).set(11).set(8).set(16);
+    EXPECT_EQ(FloodFill<5>::grow(b), expected)
+        << "Middle cell grew to the wrong cells.\n";
+
+    // (4, 4) must not wrap around to (0, 0) or (4, 0)
+    b = Board().set(24);
+    EXPECT_EQ(FloodFill<5>::grow(b), Board().set(24).set(19).set(23))
+        << "Far corner cell grew to the wrong cells.\n";
+}
+
+TEST(FloodFill_5, winding_path) {
+    HexState<5> state;
+    // a path for TWO that has to double back on itself in x
+    const int path[][2] = {
+        {0, 0}, {1, 0}, {2, 0}, {3, 0}, {3, 1}, {3, 2}, {2, 2}, {1, 2},
+        {1, 3}, {1, 4}, {2, 4}, {3, 4}, {4, 4}
+    };
+    for (auto [x, y] : path) {
+        state.succeed(Action(x, y, PLAYER_TWO));
+    }
+    auto ones = state.stones_of(PLAYER_ONE), twos = state.stones_of(PLAYER_TWO);
+    EXPECT_EQ(FloodFill<5>::who_won(ones, twos), PLAYER_TWO)
+        << "Winding path for TWO was not a win.\n";
+
+    state.succeed(Action(4, 4, PLAYER_NONE));
+    twos = state.stones_of(PLAYER_TWO);
+    EXPECT_EQ(FloodFill<5>::who_won(ones, twos), PLAYER_NONE)
+        << "Unfinished winding path for TWO was a win.\n";
+}
+
+template<int bsize>
+void random_boards() {
+    std::mt19937 rng(bsize);
+    std::uniform_int_distribution<int> colour(0, 2);
+
+    for (int trial = 0; trial < 500; trial++) {
+        HexState<bsize> state;
+        for (int x = 0; x < bsize; x++) {
+            for (int y = 0; y < bsize; y++) {
+                // a third of the boards are completely full
+                const int c = trial % 3 == 0 ? 1 + colour(rng) % 2 : colour(rng);
+                state.succeed(Action(x, y, static_cast<GameState::PLAYERS>(c)));
+            }
+        }
+        ASSERT_EQ(
+            FloodFill<bsize>::who_won(
+                state.stones_of(PLAYER_ONE), state.stones_of(PLAYER_TWO)
+            ),
+            state.who_won_search()
+        ) << "FloodFill disagreed with the search on a " << bsize
+          << " board (trial " << trial << ").\n";
+    }
+}
+
+TEST(FloodFill, random_boards) {
+    random_boards<1>();
+    random_boards<2>();
+    random_boards<3>();
+    random_boards<5>();
+    random_boards<7>();
+    random_boards<8>();
+    random_boards<9>();
+    random_boards<11>();
+    random_boards<13>();
+    random_boards<16>();
+    random_boards<17>();
+}
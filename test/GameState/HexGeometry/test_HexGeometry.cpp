@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameState/FloodFill.hpp"
+#include "hex-ai/GameState/HexGeometry.hpp"
+
+using GameState::FloodFill;
+using GameState::HexGeometry;
+
+// the tables are usable at compile time
+static_assert(HexGeometry<5>::degree[0] == 2);
+static_assert(HexGeometry<5>::degree[4] == 3);
+static_assert(HexGeometry<5>::degree[12] == 6);
+static_assert(HexGeometry<5>::unpad[HexGeometry<5>::pad(12)] == 12);
+
+TEST(HexGeometry_1, single_cell) {
+    EXPECT_EQ(HexGeometry<1>::degree[0], 0);
+    EXPECT_EQ(HexGeometry<1>::padded_cells, 9);
+    EXPECT_EQ(HexGeometry<1>::pad(0), 4);
+}
+
+template<int bsize>
+void check_tables() {
+    using G = HexGeometry<bsize>;
+    int sentinels = 0;
+    for (int p = 0; p < G::padded_cells; p++) {
+        if (G::unpad[p] < 0) {
+            ++sentinels;
+        } else {
+            ASSERT_EQ(G::pad(G::unpad[p]), p);
+        }
+    }
+    EXPECT_EQ(sentinels, 4 * bsize + 4);
+
+    for (int c = 0; c < G::cells; c++) {
+        typename G::Board single;
+        single.set(c);
+        // the neighbours agree with growing a single cell
+        ASSERT_EQ(G::adjacent[c] | single, FloodFill<bsize>::grow(single))
+            << "Cell " << c << " of a " << bsize << " board.\n";
+        ASSERT_EQ(G::adjacent[c].count(), G::degree[c]);
+
+        for (int d = 0; d < G::degree[c]; d++) {
+            const int n = G::neighbours[c][d];
+            // being neighbours goes both ways
+            ASSERT_TRUE(G::adjacent[n].test(c));
+        }
+
+        // in the padded layout every step is a fixed offset, onto a cell or a sentinel
+        int on_board = 0;
+        for (const int offset : G::padded_offsets) {
+            const int n = G::pad(c) + offset;
+            ASSERT_GE(n, 0);
+            ASSERT_LT(n, G::padded_cells);
+            if (G::unpad[n] >= 0) {
+                ASSERT_TRUE(G::adjacent[c].test(G::unpad[n]));
+                ++on_board;
+            }
+        }
+        ASSERT_EQ(on_board, G::degree[c]);
+    }
+}
+
+TEST(HexGeometry, tables) {
+    check_tables<2>();
+    check_tables<3>();
+    check_tables<5>();
+    check_tables<8>();
+    check_tables<11>();
+    check_tables<13>();
+}
@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: GPL-3.0-or-later
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <iterator>
+#include <ranges>
+#include <type_traits>
 
 #include <gtest/gtest.h>
 
@@ -19,6 +22,17 @@ using GameState::PLAYERS::PLAYER_NONE;
 using GameState::PLAYERS::PLAYER_ONE;
 using GameState::PLAYERS::PLAYER_TWO;
 
+static_assert(std::forward_iterator<HexState<1>::ActionIterator>);
+static_assert(std::forward_iterator<HexState<11>::ActionIterator>);
+// dereferencing makes an Action, so nothing refers back into an iterator
+static_assert(std::is_same_v<std::iter_reference_t<HexState<5>::ActionIterator>, GameState::Action>);
+static_assert(std::ranges::forward_range<HexState<11>>);
+// but the legacy category can't promise a real reference, so it stays an input iterator
+static_assert(std::is_same_v<
+    std::iterator_traits<HexState<5>::ActionIterator>::iterator_category,
+    std::input_iterator_tag
+>);
+
 TEST(HexState1_ActionIterator, DefaultPlayer) {
     HexState<1> state;
     HexState<1>::ActionIterator start = state.begin(),
@@ -169,3 +183,40 @@ TEST(HexState4_GetActions, SetPlayerByState) {
     }
 }
 
+
+TEST(HexState4_ActionIterator, MultiPass) {
+    HexState<4> state;
+    state.succeed(Action(1, 1, PLAYER_ONE));
+    state.succeed(Action(2, 3, PLAYER_TWO));
+
+    HexState<4>::ActionIterator start = state.begin(), copy = start;
+    ++start;
+    ++start;
+    EXPECT_EQ(*copy, Action(0, 0, PLAYER_NONE))
+        << "Copy of an iterator moved along with the original.\n";
+    EXPECT_EQ(std::distance(copy, state.end()), 14)
+        << "4x4 with 2 stones did not have 14 moves.\n";
+    EXPECT_EQ(std::distance(start, state.end()), 12)
+        << "Advanced iterator did not have 12 moves left.\n";
+}
+
+TEST(HexState4_ActionIterator, Ranges) {
+    HexState<4> state;
+    state.default_iter_whose = PLAYER_TWO;
+    state.succeed(Action(0, 0, PLAYER_ONE));
+    state.succeed(Action(3, 3, PLAYER_TWO));
+
+    EXPECT_EQ(std::ranges::distance(state), 14)
+        << "4x4 with 2 stones did not have 14 moves.\n";
+    EXPECT_EQ(std::ranges::count_if(state, [](const Action &a) { return a.x == 3; }), 3)
+        << "4x4 did not have 3 moves at x = 3.\n";
+
+    auto found = std::ranges::find(state, Action(2, 1, PLAYER_TWO));
+    ASSERT_NE(found, state.end())
+        << "Could not find (2, 1, TWO) on a 4x4.\n";
+    EXPECT_EQ(std::ranges::distance(found, state.end()), 6)
+        << "(2, 1) was not 6 moves from the end.\n";
+
+    EXPECT_EQ(std::ranges::find(state, Action(0, 0, PLAYER_TWO)), state.end())
+        << "Found an action on an occupied cell.\n";
+}
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/StaticActionList.hpp"
 #include "hex-ai/GameState/enums.hpp"
 #include "hex-ai/GameState/Action.hpp"
 
@@ -125,3 +126,58 @@ TEST(HexState4_GetActions, WonBoard) {
         << "get_actions returned the wrong amount of actions.";
 }
 
+TEST(HexState4_GetActions, StaticListMatchesVector) {
+    HexState<4> state;
+    state.succeed(Action(0, 1, PLAYER_ONE));
+    state.succeed(Action(2, 2, PLAYER_TWO));
+    state.succeed(Action(3, 0, PLAYER_ONE));
+    std::vector<Action> v;
+    GameState::StaticActionList<4> list;
+
+    state.get_actions(v, PLAYER_TWO);
+    state.get_actions(list, PLAYER_TWO);
+    ASSERT_EQ(list.size(), v.size())
+        << "get_actions into a StaticActionList returned the wrong amount of actions.";
+    for (size_t i = 0; i < v.size(); i++) {
+        EXPECT_EQ(list[i], v[i])
+            << "Action at " << i << " had bad value.";
+    }
+}
+
+TEST(HexState4_GetActions, StaticListRefills) {
+    HexState<4> state;
+    GameState::StaticActionList<4> list;
+
+    state.get_actions(list);
+    state.get_actions(list);
+    EXPECT_EQ(list.size(), 16)
+        << "get_actions did not empty a StaticActionList before filling it.";
+
+    state.succeed({0, 0, PLAYER_ONE});
+    state.succeed({0, 1, PLAYER_ONE});
+    state.succeed({0, 2, PLAYER_ONE});
+    state.succeed({0, 3, PLAYER_ONE});
+    state.get_actions(list);
+    EXPECT_TRUE(list.empty())
+        << "get_actions gave actions on a won board.";
+}
+
+TEST(HexState4_GetActions, EmptyCount) {
+    HexState<4> state;
+    EXPECT_EQ(state.empty_count(), 16);
+
+    state.succeed(Action(0, 1, PLAYER_ONE));
+    state.succeed(Action(2, 2, PLAYER_TWO));
+    EXPECT_EQ(state.empty_count(), 14);
+
+    // taking over a cell does not change how many are empty
+    state.succeed(Action(2, 2, PLAYER_ONE));
+    EXPECT_EQ(state.empty_count(), 14);
+
+    state.succeed(Action(0, 1, PLAYER_NONE));
+    EXPECT_EQ(state.empty_count(), 15);
+
+    state.flip(GameState::BOTH);
+    EXPECT_EQ(state.empty_count(), 15);
+    EXPECT_EQ(state.empty_count(), state.empty_cells().count());
+}
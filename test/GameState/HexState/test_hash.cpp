@@ -0,0 +1,130 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <array>
+#include <functional>
+#include <random>
+#include <set>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/Zobrist.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/GameState/Action.hpp"
+
+using GameState::Action;
+using GameState::HexState;
+using GameState::Zobrist;
+using GameState::PLAYERS::PLAYER_NONE;
+using GameState::PLAYERS::PLAYER_ONE;
+using GameState::PLAYERS::PLAYER_TWO;
+
+template<int bsize>
+uint64_t from_scratch(const HexState<bsize> &state) {
+    return Zobrist<bsize>::of(state.stones_of(PLAYER_ONE), state.stones_of(PLAYER_TWO));
+}
+
+TEST(HexState_4_hash, empty) {
+    HexState<4> state;
+
+    EXPECT_EQ(state.hash(), 0);
+    EXPECT_EQ(std::hash<HexState<4>>{}(state), 0);
+}
+
+TEST(HexState_4_hash, move_and_undo) {
+    HexState<4> state;
+    Action back;
+
+    state.succeed({1, 2, PLAYER_ONE});
+    const uint64_t one_stone = state.hash();
+    EXPECT_NE(one_stone, 0);
+    EXPECT_EQ(one_stone, from_scratch(state));
+
+    state.succeed({3, 0, PLAYER_TWO}, back);
+    EXPECT_NE(state.hash(), one_stone);
+    EXPECT_EQ(state.hash(), from_scratch(state));
+
+    state.succeed(back);
+    EXPECT_EQ(state.hash(), one_stone);
+}
+
+TEST(HexState_4_hash, move_order) {
+    HexState<4> a, b;
+
+    a.succeed({0, 0, PLAYER_ONE});
+    a.succeed({1, 1, PLAYER_TWO});
+    a.succeed({2, 2, PLAYER_ONE});
+    b.succeed({2, 2, PLAYER_ONE});
+    b.succeed({1, 1, PLAYER_TWO});
+    b.succeed({0, 0, PLAYER_ONE});
+
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(a, b);
+}
+
+TEST(HexState_4_hash, overwrite_and_flip) {
+    HexState<4> state;
+
+    state.succeed({0, 3, PLAYER_ONE});
+    state.succeed({0, 3, PLAYER_TWO});
+    state.succeed({2, 1, PLAYER_ONE});
+    EXPECT_EQ(state.hash(), from_scratch(state));
+
+    state.flip(GameState::BOTH);
+    EXPECT_EQ(state.hash(), from_scratch(state));
+    EXPECT_EQ(state[3][0], PLAYER_TWO);
+}
+
+TEST(HexState_11_hash, distinct_positions) {
+    std::mt19937 rng(11);
+    std::set<std::array<uint64_t, 4>> positions;
+    std::unordered_set<uint64_t> seen;
+    std::unordered_set<uint64_t> low_bits;
+
+    for (int game = 0; game < 100; game++) {
+        HexState<11> state;
+        for (int move = 0; move < 121; move++) {
+            const int cell = rng() % 121;
+            const GameState::PLAYERS whose = move % 2 ? PLAYER_TWO : PLAYER_ONE;
+            state.succeed(Action(cell / 11, cell % 11, whose));
+            ASSERT_EQ(state.hash(), from_scratch(state));
+
+            const auto &ones = state.stones_of(PLAYER_ONE), &twos = state.stones_of(PLAYER_TWO);
+            positions.insert({ ones.word(0), ones.word(1), twos.word(0), twos.word(1) });
+            seen.insert(state.hash());
+            low_bits.insert(state.hash() & 0xfffff);
+        }
+    }
+
+    // no two different positions should share a key,
+    // and the low 20 bits alone should hardly ever collide either
+    EXPECT_EQ(seen.size(), positions.size());
+    EXPECT_GT(low_bits.size(), positions.size() * 98 / 100);
+}
+
+TEST(HexState_5_hash, canonical) {
+    std::mt19937 rng(5);
+
+    for (int trial = 0; trial < 200; trial++) {
+        HexState<5> state;
+        for (int move = 0; move < trial % 20; move++) {
+            const int cell = rng() % 25;
+            state.succeed(Action(cell / 5, cell % 5, move % 2 ? PLAYER_TWO : PLAYER_ONE));
+        }
+        HexState<5> rotated = state;
+        rotated.flip(GameState::BOTH);
+
+        const auto canonical = state.canonical();
+        EXPECT_EQ(canonical, rotated.canonical())
+            << "A board and its rotation had different canonical forms.\n";
+        EXPECT_EQ(canonical.key, state.canonical_hash());
+        EXPECT_EQ(canonical.key, std::min(state.hash(), rotated.hash()));
+        EXPECT_TRUE(canonical == state.position() || canonical == rotated.position())
+            << "Canonical form was not one of the two orientations.\n";
+    }
+}
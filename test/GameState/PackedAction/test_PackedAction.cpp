@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <cereal/cereal.hpp>
+
+#include "cereal/archives/binary.hpp"
+#include "hex-ai/GameSolve/HexUtil.hpp"
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+using GameState::Action;
+using GameState::HexState;
+using GameState::PackedAction;
+using GameState::PLAYERS::PLAYER_NONE;
+using GameState::PLAYERS::PLAYER_ONE;
+using GameState::PLAYERS::PLAYER_TWO;
+
+static_assert(PackedAction(37, PLAYER_TWO).cell() == 37);
+static_assert(PackedAction(37, PLAYER_TWO).whose() == PLAYER_TWO);
+static_assert(PackedAction(PackedAction::max_cell, PLAYER_ONE).cell() == PackedAction::max_cell);
+
+template<int bsize>
+void round_trips() {
+    for (int x = 0; x < bsize; x++) {
+        for (int y = 0; y < bsize; y++) {
+            for (GameState::PLAYERS p : { PLAYER_NONE, PLAYER_ONE, PLAYER_TWO }) {
+                const Action a(x, y, p);
+                const PackedAction packed = PackedAction::from<bsize>(a);
+                EXPECT_EQ(packed.cell(), x * bsize + y);
+                EXPECT_EQ(packed.whose(), p);
+                EXPECT_EQ(packed.unpack<bsize>(), a)
+                    << "(" << x << ", " << y << ") did not survive being packed.";
+            }
+        }
+    }
+}
+
+TEST(PackedAction, round_trips) {
+    round_trips<1>();
+    round_trips<5>();
+    round_trips<11>();
+    round_trips<19>();
+}
+
+TEST(PackedAction, with_whose) {
+    const PackedAction a(12, PLAYER_ONE);
+    EXPECT_EQ(a.with_whose(PLAYER_TWO), PackedAction(12, PLAYER_TWO));
+    EXPECT_EQ(a.with_whose(PLAYER_NONE).cell(), 12);
+}
+
+TEST(PackedAction, succeed_matches_action) {
+    for (int n = 0; n < 256; n++) {
+        HexState<7> random;
+        GameSolve::hex_rand_moves(random, 20, PLAYER_ONE);
+
+        HexState<7> by_action, by_packed;
+        for (int c = 0; c < 49; c++) {
+            const Action a(c / 7, c % 7, random.at(c / 7, c % 7));
+            by_action.succeed(a);
+            by_packed.succeed(PackedAction::from<7>(a));
+        }
+        EXPECT_EQ(by_action, by_packed);
+        EXPECT_EQ(by_action.hash(), by_packed.hash());
+        EXPECT_EQ(by_action.who_won(), by_packed.who_won());
+    }
+}
+
+TEST(PackedAction, succeed_undoes) {
+    HexState<5> state;
+    GameSolve::hex_rand_moves(state, 6, PLAYER_ONE);
+    const HexState<5> before = state;
+
+    PackedAction back;
+    state.default_iter_whose = PLAYER_TWO;
+    for (auto it = state.begin(); it != state.end(); ++it) {
+        EXPECT_EQ(it.packed().unpack<5>(), *it);
+        state.succeed(it.packed(), back);
+        EXPECT_NE(state, before);
+        state.succeed(back);
+        EXPECT_EQ(state, before);
+    }
+}
+
+TEST(PackedAction, get_actions) {
+    HexState<4> state;
+    state.succeed(Action(0, 1, PLAYER_ONE));
+    state.succeed(Action(2, 2, PLAYER_TWO));
+    std::vector<Action> actions;
+    std::vector<PackedAction> packed;
+
+    // twice, so that the second lot goes after the first
+    for (int i = 0; i < 2; i++) {
+        state.get_actions(actions, PLAYER_ONE);
+        state.get_actions(packed, PLAYER_ONE);
+    }
+    ASSERT_EQ(packed.size(), 28);
+    ASSERT_EQ(actions.size(), packed.size());
+    for (size_t i = 0; i < actions.size(); i++) {
+        EXPECT_EQ(packed[i].unpack<4>(), actions[i]);
+    }
+}
+
+TEST(PackedAction, cereal) {
+    std::vector<PackedAction> original, read;
+    for (int c = 0; c < 121; c++) {
+        original.emplace_back(c, c % 2 ? PLAYER_ONE : PLAYER_TWO);
+    }
+    std::stringstream s;
+    {
+        cereal::BinaryOutputArchive arc(s);
+        for (PackedAction &a : original) {
+            arc(a);
+        }
+    }
+    cereal::BinaryInputArchive arc(s);
+    read.resize(original.size());
+    for (PackedAction &a : read) {
+        arc(a);
+    }
+    EXPECT_EQ(read, original);
+    EXPECT_EQ(s.str().size(), 2 * original.size())
+        << "a PackedAction should take up two bytes in an archive.";
+}
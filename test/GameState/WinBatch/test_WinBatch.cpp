@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/WinBatch.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+using GameState::Action;
+using GameState::HexState;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+// make sure boards of more than one word go through the batch too
+template<> struct GameState::HexConfig<9> { static constexpr WIN_CHECK win_check = WIN_FLOOD; };
+template<> struct GameState::HexConfig<13> { static constexpr WIN_CHECK win_check = WIN_SEARCH; };
+
+template<int bsize>
+void random_batch(size_t count) {
+    std::mt19937 rng(bsize);
+    std::vector<HexState<bsize>> states(count);
+    std::vector<GameState::PLAYERS> winners(count, PLAYER_NONE);
+
+    for (size_t i = 0; i < count; i++) {
+        // a third of the boards are completely full, the rest partly
+        for (int x = 0; x < bsize; x++) {
+            for (int y = 0; y < bsize; y++) {
+                const int c = i % 3 == 0 ? 1 + rng() % 2 : rng() % 3;
+                states[i].succeed(Action(x, y, static_cast<GameState::PLAYERS>(c)));
+            }
+        }
+    }
+
+    GameState::who_won_many<bsize>(states, winners);
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(winners[i], states[i].who_won_search())
+            << "Batch disagreed on state " << i << " of a " << bsize << " board.\n";
+    }
+}
+
+TEST(WinBatch, random_boards) {
+    random_batch<1>(70);
+    random_batch<2>(64);
+    random_batch<5>(1000);
+    random_batch<8>(129);
+    random_batch<9>(200);
+    random_batch<11>(100);
+    random_batch<13>(100);
+}
+
+TEST(WinBatch_9, lanes_are_independent) {
+    std::vector<HexState<9>> states(64);
+    std::vector<GameState::PLAYERS> winners(64);
+
+    // state j wins for ONE along x = j % 9 only if j is even (9x9 boards take two words, so they go through the batch)
+    for (int j = 0; j < 64; j++) {
+        for (int y = 0; y < 9; y++) {
+            if (j % 2 == 0 || y != 4) {
+                states[j].succeed(Action(j % 9, y, PLAYER_ONE));
+            }
+        }
+    }
+    GameState::who_won_many<9>(states, winners);
+    for (int j = 0; j < 64; j++) {
+        EXPECT_EQ(winners[j], j % 2 == 0 ? PLAYER_ONE : PLAYER_NONE) << "lane " << j;
+    }
+
+    // an empty batch is fine too
+    GameState::who_won_many<9>({}, {});
+}
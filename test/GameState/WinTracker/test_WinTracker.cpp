@@ -0,0 +1,124 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameState/Action.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/WinTracker.hpp"
+#include "hex-ai/GameState/enums.hpp"
+
+using GameState::Action;
+using GameState::HexState;
+using GameState::WinTracker;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+// small boards flood fill by default, make sure they use the tracker here
+template<> struct GameState::HexConfig<2> { static constexpr WIN_CHECK win_check = WIN_UNION_FIND; };
+template<> struct GameState::HexConfig<4> { static constexpr WIN_CHECK win_check = WIN_UNION_FIND; };
+template<> struct GameState::HexConfig<5> { static constexpr WIN_CHECK win_check = WIN_UNION_FIND; };
+template<> struct GameState::HexConfig<8> { static constexpr WIN_CHECK win_check = WIN_UNION_FIND; };
+
+TEST(WinTracker_4, empty) {
+    WinTracker<4> t;
+
+    EXPECT_EQ(t.winner(), PLAYER_NONE)
+        << "Empty tracker had a winner.\n";
+}
+
+TEST(WinTracker_4, add_and_undo) {
+    WinTracker<4> t;
+    WinTracker<4>::Board ones;
+
+    for (int y = 0; y < 4; y++) {
+        t.add(2 * 4 + y, PLAYER_ONE, ones.set(2 * 4 + y));
+    }
+    EXPECT_EQ(t.winner(), PLAYER_ONE)
+        << "Straight line for ONE was not a win.\n";
+
+    EXPECT_FALSE(t.undo(2 * 4 + 0))
+        << "Tracker undid a stone that was not the last one added.\n";
+    EXPECT_TRUE(t.undo(2 * 4 + 3));
+    EXPECT_EQ(t.winner(), PLAYER_NONE)
+        << "Taking back the winning stone did not take back the win.\n";
+}
+
+TEST(WinTracker_4, rebuild) {
+    WinTracker<4> t;
+    WinTracker<4>::Board ones, twos;
+    for (int x = 0; x < 4; x++) {
+        twos.set(x * 4 + 1);
+    }
+
+    t.rebuild(ones, twos);
+    EXPECT_EQ(t.winner(), PLAYER_TWO)
+        << "Rebuilt straight line for TWO was not a win.\n";
+}
+
+/*
+ * Play random games on a HexState, taking back moves along the way
+ * the same way the solvers do, and make sure the tracked winner always
+ * agrees with searching the board.
+ */
+template<int bsize>
+void random_play_and_undo() {
+    std::minstd_rand rand(bsize);
+
+    for (int game = 0; game < 512; game++) {
+        HexState<bsize> state;
+        std::vector<Action> backs;
+        GameState::PLAYERS turn = PLAYER_ONE;
+
+        while (state.who_won() == PLAYER_NONE) {
+            std::vector<Action> actions;
+            state.get_actions(actions, turn);
+            ASSERT_FALSE(actions.empty());
+
+            backs.emplace_back();
+            state.succeed(actions[rand() % actions.size()], backs.back());
+            turn = turn == PLAYER_ONE ? PLAYER_TWO : PLAYER_ONE;
+            ASSERT_EQ(state.who_won(), state.who_won_search());
+
+            // every so often take a few moves back
+            if (rand() % 4 == 0) {
+                for (int back = rand() % 3; back > 0 && !backs.empty(); back--) {
+                    state.succeed(backs.back());
+                    backs.pop_back();
+                    turn = turn == PLAYER_ONE ? PLAYER_TWO : PLAYER_ONE;
+                    ASSERT_EQ(state.who_won(), state.who_won_search());
+                }
+            }
+        }
+    }
+}
+
+TEST(WinTracker_HexState, random_play_and_undo) {
+    random_play_and_undo<2>();
+    random_play_and_undo<5>();
+    random_play_and_undo<8>();
+    random_play_and_undo<11>();
+}
+
+TEST(WinTracker_HexState, overwrite_stones) {
+    HexState<4> state;
+    for (unsigned char y = 0; y < 4; y++) {
+        state.succeed({1, y, PLAYER_ONE});
+    }
+    EXPECT_EQ(state.who_won(), PLAYER_ONE);
+
+    // take a stone out of the middle of the line, then give it to TWO
+    state.succeed({1, 1, PLAYER_NONE});
+    EXPECT_EQ(state.who_won(), PLAYER_NONE);
+    state.succeed({1, 1, PLAYER_ONE});
+    EXPECT_EQ(state.who_won(), PLAYER_ONE);
+    state.succeed({1, 1, PLAYER_TWO});
+    EXPECT_EQ(state.who_won(), PLAYER_NONE);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Io/SolvedDatabase0.hpp"
+
+using GameState::PackedAction;
+using GameState::PLAYER_NONE;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+static std::string temp_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static GameState::PLAYERS other(GameState::PLAYERS p) {
+    return p == PLAYER_ONE ? PLAYER_TWO : PLAYER_ONE;
+}
+
+// call `f` once on every state reachable from `state` which nobody has won
+template<int bsize, class F>
+static void each_reachable(
+    GameState::HexState<bsize> &state,
+    GameState::PLAYERS mover,
+    F &f,
+    std::unordered_set<uint64_t> &seen
+) {
+    if (state.who_won() != PLAYER_NONE || !seen.insert(Io::SolvedDatabase0<bsize>::key_of(state)).second) {
+        return;
+    }
+    f(state, mover);
+    const auto empty = state.empty_cells();
+    for (int c = empty.next(); c < bsize * bsize; c = empty.next(c + 1)) {
+        state.succeed(PackedAction(c, mover));
+        each_reachable(state, other(mover), f, seen);
+        state.succeed(PackedAction(c, PLAYER_NONE));
+    }
+}
+
+// write every state reachable from `state` to `path`, solved by `ab`
+template<int bsize>
+static void write_reachable(
+    const std::string &path,
+    GameState::HexState<bsize> state,
+    GameState::PLAYERS mover,
+    GameSolve::AlphaBeta2PlayersCached<bsize> &ab
+) {
+    std::ofstream out(path, std::ofstream::binary);
+    Io::SolvedDatabase0Writer<bsize> writer(out);
+    auto push = [&](GameState::HexState<bsize> &s, GameState::PLAYERS m) {
+        writer.push(s, m == PLAYER_ONE ? ab.one_wins_one_turn(s) : ab.one_wins_two_turn(s));
+    };
+    std::unordered_set<uint64_t> seen;
+    each_reachable(state, mover, push, seen);
+    ASSERT_EQ(writer.finish(), Io::SolvedDatabase0Writer<bsize>::CLEAR);
+}
+
+TEST(test_SolvedDatabase0, every_3x3_state) {
+    const std::string path = temp_path("test_SolvedDatabase0_3.db");
+    GameSolve::AlphaBeta2PlayersCached<3> ab {1 << 16};
+    write_reachable<3>(path, GameState::HexState<3>(), PLAYER_ONE, ab);
+
+    Io::SolvedDatabase0Reader<3> reader(path);
+    ASSERT_EQ(reader.read_err(), Io::SolvedDatabase0Reader<3>::CLEAR);
+
+    GameState::HexState<3> empty;
+    auto check = [&](GameState::HexState<3> &s, GameState::PLAYERS m) {
+        GameSolve::AlphaBeta2PlayersCached<3> fresh {1 << 10};
+        const bool expected = m == PLAYER_ONE ? fresh.one_wins_one_turn(s) : fresh.one_wins_two_turn(s);
+        ASSERT_EQ(reader.one_wins(s, m), std::optional<bool>(expected))
+            << "A state was missing or had the wrong winner.\n";
+        GameState::HexState<3> rotated = s;
+        rotated.flip(GameState::BOTH);
+        EXPECT_EQ(reader.one_wins(rotated, m), std::optional<bool>(expected))
+            << "A rotated state was missing or had the wrong winner.\n";
+        EXPECT_FALSE(reader.one_wins(s, other(m)).has_value())
+            << "A state was found with the wrong player to move.\n";
+    };
+    std::unordered_set<uint64_t> seen;
+    each_reachable(empty, PLAYER_ONE, check, seen);
+    EXPECT_EQ(reader.size(), seen.size()) << "The wrong amount of states were written.\n";
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_SolvedDatabase0, small_runs) {
+    // a writer that can only hold a few records at once writes the same file as one that holds them all
+    const std::string path = temp_path("test_SolvedDatabase0_runs.db");
+    GameSolve::AlphaBeta2PlayersCached<3> ab {1 << 16};
+    write_reachable<3>(path, GameState::HexState<3>(), PLAYER_ONE, ab);
+    std::ifstream in(path, std::ifstream::binary);
+    const std::string whole((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::stringstream runs;
+    uint64_t written;
+    {
+        Io::SolvedDatabase0Writer<3> writer(runs, 7);
+        auto push = [&](GameState::HexState<3> &s, GameState::PLAYERS m) {
+            writer.push(s, m == PLAYER_ONE ? ab.one_wins_one_turn(s) : ab.one_wins_two_turn(s));
+            // rotations and repeats land in other runs, and are still only written once
+            GameState::HexState<3> rotated = s;
+            rotated.flip(GameState::BOTH);
+            writer.push(rotated, m == PLAYER_ONE ? ab.one_wins_one_turn(s) : ab.one_wins_two_turn(s));
+        };
+        for (int pass = 0; pass < 2; pass++) {
+            std::unordered_set<uint64_t> seen;
+            GameState::HexState<3> empty;
+            each_reachable(empty, PLAYER_ONE, push, seen);
+        }
+        ASSERT_EQ(writer.finish(), Io::SolvedDatabase0Writer<3>::CLEAR);
+        written = writer.size();
+    }
+    EXPECT_EQ(runs.str(), whole) << "Merging runs changed the file.\n";
+    EXPECT_EQ(written, (whole.size() - Io::SolvedDatabase0<3>::header_size) / sizeof(uint64_t));
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_SolvedDatabase0, bad_files) {
+    Io::SolvedDatabase0Reader<3> missing(temp_path("test_SolvedDatabase0_missing.db"));
+    EXPECT_EQ(missing.read_err(), Io::SolvedDatabase0Reader<3>::BAD_OPEN);
+    EXPECT_FALSE(missing.one_wins(GameState::HexState<3>(), PLAYER_ONE).has_value());
+
+    // a file of 2x2 boards is not read as 3x3
+    const std::string path = temp_path("test_SolvedDatabase0_2.db");
+    GameSolve::AlphaBeta2PlayersCached<2> ab {1 << 10};
+    write_reachable<2>(path, GameState::HexState<2>(), PLAYER_ONE, ab);
+    Io::SolvedDatabase0Reader<3> wrong_size(path);
+    EXPECT_EQ(wrong_size.read_err(), Io::SolvedDatabase0Reader<3>::BAD_HEADER);
+    Io::SolvedDatabase0Reader<2> right_size(path);
+    EXPECT_EQ(right_size.read_err(), Io::SolvedDatabase0Reader<2>::CLEAR);
+
+    // and a file cut short is not read at all
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    Io::SolvedDatabase0Reader<2> cut(path);
+    EXPECT_EQ(cut.read_err(), Io::SolvedDatabase0Reader<2>::BAD_HEADER);
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_SolvedDatabase0, alpha_beta_consults) {
+    // everything after a few moves into a 4x4 game
+    GameState::HexState<4> root;
+    root.succeed(PackedAction(5, PLAYER_ONE));
+    root.succeed(PackedAction(10, PLAYER_TWO));
+    root.succeed(PackedAction(6, PLAYER_ONE));
+    root.succeed(PackedAction(9, PLAYER_TWO));
+    const std::string path = temp_path("test_SolvedDatabase0_4.db");
+    GameSolve::AlphaBeta2PlayersCached<4> builder {1 << 16};
+    write_reachable<4>(path, root, PLAYER_ONE, builder);
+    Io::SolvedDatabase0Reader<4> reader(path);
+    ASSERT_EQ(reader.read_err(), Io::SolvedDatabase0Reader<4>::CLEAR);
+
+    GameSolve::AlphaBeta2PlayersCached<4> plain {1 << 16};
+    GameSolve::AlphaBeta2PlayersCached<4> consulting {1 << 16};
+    consulting.database = &reader;
+    EXPECT_EQ(consulting.one_wins_one_turn(root), plain.one_wins_one_turn(root));
+    EXPECT_EQ(consulting.nodes_expanded, 0) << "A state in the database was searched.\n";
+
+    // the state before the last move is not in the database, but every move from it that matters is
+    GameState::HexState<4> parent = root;
+    parent.succeed(PackedAction(9, PLAYER_NONE));
+    GameSolve::AlphaBeta2PlayersCached<4> plain_parent {1 << 16};
+    EXPECT_EQ(consulting.one_wins_two_turn(parent), plain_parent.one_wins_two_turn(parent));
+    EXPECT_LT(consulting.nodes_expanded, plain_parent.nodes_expanded);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/GameSolve/AlphaBeta.hpp"
+#include "hex-ai/GameSolve/TranspositionTable.hpp"
+#include "hex-ai/GameState/HexState.hpp"
+#include "hex-ai/GameState/PackedAction.hpp"
+#include "hex-ai/GameState/enums.hpp"
+#include "hex-ai/Io/TranspositionTable0.hpp"
+
+using GameState::PackedAction;
+using GameState::PLAYER_ONE;
+using GameState::PLAYER_TWO;
+
+static std::string temp_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static void save(
+    const std::string &path,
+    const GameSolve::TranspositionTable &table,
+    int bsize = 5,
+    bool use_symmetry = true
+) {
+    std::ofstream out(path, std::ofstream::binary);
+    Io::TranspositionTable0Writer writer(out, bsize, use_symmetry);
+    ASSERT_EQ(writer.write(table), Io::TranspositionTable0Writer::CLEAR);
+}
+
+TEST(test_TranspositionTable0, round_trip) {
+    const std::string path = temp_path("test_TranspositionTable0_round_trip.tt");
+    GameSolve::TranspositionTable table(1 << 12);
+    table.new_generation();
+    for (uint64_t k = 1; k <= 1000; k++) {
+        table.store(k * 0x9e3779b97f4a7c15, static_cast<uint16_t>(k % 4096), static_cast<int>(k % 64));
+    }
+    save(path, table);
+
+    Io::TranspositionTable0Reader reader(path, 5, true);
+    ASSERT_EQ(reader.read_err(), Io::TranspositionTable0Reader::CLEAR);
+    EXPECT_EQ(reader.size(), table.capacity());
+    std::unique_ptr<GameSolve::TranspositionTable> loaded = reader.table();
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(reader.table(), nullptr) << "The file was handed over twice.\n";
+    EXPECT_EQ(loaded->capacity(), table.capacity());
+    EXPECT_EQ(loaded->current_generation(), table.current_generation());
+    for (size_t i = 0; i < table.capacity(); i++) {
+        ASSERT_EQ(loaded->entry(i), table.entry(i)) << "Entry " << i << " changed.\n";
+    }
+    for (uint64_t k = 1; k <= 1000; k++) {
+        EXPECT_EQ(loaded->probe(k * 0x9e3779b97f4a7c15), table.probe(k * 0x9e3779b97f4a7c15));
+    }
+
+    // storing to a loaded table never changes the file
+    loaded->store(12345, 7, 3);
+    EXPECT_EQ(loaded->probe(12345), std::optional<uint16_t>(7));
+    Io::TranspositionTable0Reader again(path, 5, true);
+    std::unique_ptr<GameSolve::TranspositionTable> reloaded = again.table();
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_FALSE(reloaded->probe(12345).has_value()) << "A store went through to the file.\n";
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_TranspositionTable0, bad_files) {
+    Io::TranspositionTable0Reader missing(temp_path("test_TranspositionTable0_missing.tt"), 5, true);
+    EXPECT_EQ(missing.read_err(), Io::TranspositionTable0Reader::BAD_OPEN);
+    EXPECT_EQ(missing.table(), nullptr);
+
+    // a table for 4x4 boards with symmetry is not read for any other solvers
+    const std::string path = temp_path("test_TranspositionTable0_bad.tt");
+    save(path, GameSolve::TranspositionTable(1 << 8), 4, true);
+    Io::TranspositionTable0Reader wrong_size(path, 5, true);
+    EXPECT_EQ(wrong_size.read_err(), Io::TranspositionTable0Reader::BAD_HEADER);
+    EXPECT_EQ(wrong_size.table(), nullptr);
+    Io::TranspositionTable0Reader wrong_symmetry(path, 4, false);
+    EXPECT_EQ(wrong_symmetry.read_err(), Io::TranspositionTable0Reader::BAD_HEADER);
+    Io::TranspositionTable0Reader right(path, 4, true);
+    EXPECT_EQ(right.read_err(), Io::TranspositionTable0Reader::CLEAR);
+
+    // and a file cut short is not read at all
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    Io::TranspositionTable0Reader cut(path, 4, true);
+    EXPECT_EQ(cut.read_err(), Io::TranspositionTable0Reader::BAD_HEADER);
+    EXPECT_EQ(cut.table(), nullptr);
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_TranspositionTable0, warm_start) {
+    GameState::HexState<4> root;
+    root.succeed(PackedAction(5, PLAYER_ONE));
+    root.succeed(PackedAction(10, PLAYER_TWO));
+    const std::string path = temp_path("test_TranspositionTable0_warm.tt");
+
+    GameSolve::TranspositionTable cold(1 << 16);
+    GameSolve::AlphaBeta2PlayersCached<4> first(cold, true);
+    const bool one_wins = first.one_wins_one_turn(root);
+    ASSERT_GT(first.nodes_expanded, 0);
+    save(path, cold, 4, true);
+
+    Io::TranspositionTable0Reader reader(path, 4, true);
+    std::unique_ptr<GameSolve::TranspositionTable> warm = reader.table();
+    ASSERT_NE(warm, nullptr);
+    GameSolve::AlphaBeta2PlayersCached<4> second(*warm, true);
+    EXPECT_EQ(second.one_wins_one_turn(root), one_wins);
+    EXPECT_EQ(second.nodes_expanded, 0) << "A solved state was searched again after loading.\n";
+
+    // and states past the root were saved too
+    GameState::HexState<4> child = root;
+    child.succeed(PackedAction(6, PLAYER_ONE));
+    GameSolve::AlphaBeta2PlayersCached<4> fresh(1 << 16, true);
+    EXPECT_EQ(second.one_wins_two_turn(child), fresh.one_wins_two_turn(child));
+    EXPECT_LT(second.nodes_expanded, fresh.nodes_expanded);
+
+    std::filesystem::remove(path);
+}
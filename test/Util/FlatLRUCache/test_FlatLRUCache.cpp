@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cstdint>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/Util/FlatLRUCache.hpp"
+#include "hex-ai/Util/LRUCache.hpp"
+
+// a hash that puts every key in the same place
+struct Clash {
+    size_t operator()(uint64_t) const {
+        return 7;
+    }
+};
+
+TEST(test_FlatLRUCache, insert_and_lookup) {
+    Cache::FlatLRUCache<uint64_t, int> cache(100);
+    int v;
+    EXPECT_FALSE(cache.lookup(3, v));
+    for (uint64_t k = 0; k < 100; k++) {
+        cache.insert(k, int(k) * 2);
+    }
+    EXPECT_EQ(cache.size(), 100u);
+    for (uint64_t k = 0; k < 100; k++) {
+        ASSERT_TRUE(cache.lookup(k, v)) << "Key " << k << " went missing.";
+        EXPECT_EQ(v, int(k) * 2);
+    }
+    EXPECT_FALSE(cache.lookup(100, v));
+
+    *cache.find(5) = -1;
+    ASSERT_TRUE(cache.lookup(5, v));
+    EXPECT_EQ(v, -1) << "A value changed through find did not stay changed.";
+}
+
+TEST(test_FlatLRUCache, forgets_least_recently_used) {
+    Cache::FlatLRUCache<uint64_t, int> cache(3);
+    int v;
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+    ASSERT_TRUE(cache.lookup(1, v));
+    cache.insert(4, 4);
+    EXPECT_FALSE(cache.lookup(2, v)) << "The least recently used key was kept.";
+    EXPECT_TRUE(cache.lookup(1, v));
+    EXPECT_TRUE(cache.lookup(3, v));
+    EXPECT_TRUE(cache.lookup(4, v));
+    EXPECT_EQ(cache.size(), 3u);
+
+    Cache::FlatLRUCache<uint64_t, int> one(1);
+    one.insert(1, 1);
+    one.insert(2, 2);
+    EXPECT_FALSE(one.lookup(1, v));
+    EXPECT_TRUE(one.lookup(2, v));
+}
+
+// the same keys, looked up and inserted in the same order, are kept by LRUCache and FlatLRUCache
+template<class Hash>
+void agrees_with_lru(unsigned int capacity, uint64_t key_range) {
+    Cache::LRUCache<uint64_t, uint64_t> lru(capacity);
+    Cache::FlatLRUCache<uint64_t, uint64_t, Hash> flat(capacity);
+    std::mt19937_64 rng(capacity);
+    for (int i = 0; i < 50000; i++) {
+        const uint64_t k = rng() % key_range;
+        uint64_t from_lru, from_flat;
+        const bool in_lru = lru.lookup(k, from_lru);
+        const bool in_flat = flat.lookup(k, from_flat);
+        ASSERT_EQ(in_lru, in_flat) << "Key " << k << " was found in only one cache at step " << i << ".";
+        if (in_lru) {
+            ASSERT_EQ(from_lru, from_flat);
+        } else {
+            lru.insert(k, k * 3 + i);
+            flat.insert(k, k * 3 + i);
+        }
+    }
+}
+
+TEST(test_FlatLRUCache, agrees_with_lru_cache) {
+    for (unsigned int capacity : { 2u, 7u, 100u, 4096u }) {
+        agrees_with_lru<std::hash<uint64_t>>(capacity, capacity + capacity / 2 + 1);
+    }
+}
+
+TEST(test_FlatLRUCache, every_key_clashing) {
+    agrees_with_lru<Clash>(60, 90);
+}
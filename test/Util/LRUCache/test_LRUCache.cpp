@@ -0,0 +1,115 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/Util/LRUCache.hpp"
+
+template<Cache::Eviction eviction>
+using Cached = Cache::LRUCache<uint64_t, int, std::hash<uint64_t>, eviction>;
+
+// only CLOCK nodes have room for a mark
+static_assert(
+    sizeof(Cache::LRUCache<uint64_t, uint64_t>::LLNode) == 4 * sizeof(void *) + 2 * sizeof(uint64_t)
+);
+static_assert(
+    sizeof(Cache::LRUCache<uint64_t, uint64_t, std::hash<uint64_t>, Cache::Eviction::CLOCK>::LLNode)
+    > sizeof(Cache::LRUCache<uint64_t, uint64_t>::LLNode)
+);
+
+TEST(test_LRUCache, forgets_least_recently_used) {
+    Cached<Cache::Eviction::LRU> cache(3);
+    int v;
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+    ASSERT_TRUE(cache.lookup(1, v));
+    cache.insert(4, 4);
+    EXPECT_FALSE(cache.lookup(2, v)) << "The least recently used key was kept.";
+    EXPECT_TRUE(cache.lookup(1, v));
+    EXPECT_TRUE(cache.lookup(3, v));
+    EXPECT_TRUE(cache.lookup(4, v));
+}
+
+TEST(test_LRUCache, clock_gives_second_chances) {
+    Cached<Cache::Eviction::CLOCK> cache(3);
+    int v;
+    for (uint64_t k = 1; k <= 3; k++) {
+        cache.insert(k, int(k));
+    }
+    // every key is new, so the hand goes all the way around and takes the first
+    cache.insert(4, 4);
+    EXPECT_FALSE(cache.lookup(1, v));
+    // 2 and 3 have been passed over once, and 3 is used again
+    ASSERT_TRUE(cache.lookup(3, v));
+    EXPECT_EQ(v, 3);
+    cache.insert(5, 5);
+    EXPECT_FALSE(cache.lookup(2, v)) << "A key nobody used since the hand passed it was kept.";
+    EXPECT_TRUE(cache.lookup(3, v)) << "A key used since the hand passed it was forgotten.";
+    EXPECT_TRUE(cache.lookup(4, v));
+    EXPECT_TRUE(cache.lookup(5, v));
+    EXPECT_EQ(cache.used, 3u);
+}
+
+TEST(test_LRUCache, clock_keeps_every_key_that_fits) {
+    Cached<Cache::Eviction::CLOCK> cache(500);
+    int v;
+    for (uint64_t k = 0; k < 2000; k++) {
+        cache.insert(k, int(k));
+        ASSERT_TRUE(cache.lookup(k, v));
+        EXPECT_EQ(v, int(k));
+    }
+    int kept = 0;
+    for (uint64_t k = 0; k < 2000; k++) {
+        kept += cache.lookup(k, v);
+    }
+    EXPECT_EQ(kept, 500);
+}
+
+TEST(test_LRUCache, clock_lookups_from_many_threads) {
+    Cached<Cache::Eviction::CLOCK> cache(1000);
+    for (uint64_t k = 0; k < 1000; k++) {
+        cache.insert(k, int(k) * 2);
+    }
+    // the hand clears every mark on its way to some unmarked node
+    cache.insert(1000, 2000);
+
+    std::vector<std::thread> threads;
+    std::vector<int> wrong(4);
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&cache, &wrong, t] {
+            for (int round = 0; round < 20; round++) {
+                for (uint64_t k = 1; k <= 1000; k++) {
+                    int v;
+                    if (!cache.lookup(k, v) || v != int(k) * 2) {
+                        wrong[t]++;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (int w : wrong) {
+        EXPECT_EQ(w, 0);
+    }
+}
+
+TEST(test_LRUCache, keeps_one_key_at_capacity_one) {
+    Cached<Cache::Eviction::LRU> cache(1);
+    int v;
+    for (uint64_t k = 1; k <= 3; k++) {
+        cache.insert(k, int(k));
+        ASSERT_TRUE(cache.lookup(k, v));
+        EXPECT_EQ(v, int(k));
+        EXPECT_FALSE(cache.lookup(k - 1, v));
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/Util/ShardedLRUCache.hpp"
+
+TEST(test_ShardedLRUCache, insert_and_lookup) {
+    Cache::ShardedLRUCache<uint64_t, int, 8> cache(1024);
+    int v;
+    EXPECT_FALSE(cache.lookup(5, v));
+    for (uint64_t k = 0; k < 100; k++) {
+        cache.insert(k, int(k) * 2);
+    }
+    for (uint64_t k = 0; k < 100; k++) {
+        ASSERT_TRUE(cache.lookup(k, v));
+        EXPECT_EQ(v, int(k) * 2);
+    }
+    EXPECT_EQ(cache.size(), 100u);
+}
+
+TEST(test_ShardedLRUCache, insert_replaces_a_key_already_there) {
+    Cache::ShardedLRUCache<uint64_t, int, 4> cache(64);
+    int v;
+    cache.insert(7, 1);
+    cache.insert(7, 2);
+    ASSERT_TRUE(cache.lookup(7, v));
+    EXPECT_EQ(v, 2);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(test_ShardedLRUCache, never_holds_more_than_capacity) {
+    for (unsigned int capacity : { 1u, 16u, 1000u }) {
+        Cache::ShardedLRUCache<uint64_t, int, 16> cache(capacity);
+        for (uint64_t k = 0; k < 10000; k++) {
+            cache.insert(k, int(k));
+        }
+        // a shard always gets room for at least one item
+        EXPECT_LE(cache.size(), std::max(capacity, 16u));
+        int v;
+        ASSERT_TRUE(cache.lookup(9999, v)) << "The most recently inserted key was forgotten.";
+        EXPECT_EQ(v, 9999);
+    }
+}
+
+TEST(test_ShardedLRUCache, many_threads_at_once) {
+    Cache::ShardedLRUCache<uint64_t, uint64_t, 16> cache(1 << 14);
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; t++) {
+        threads.emplace_back([&cache, t]() {
+            // every thread inserts and looks up overlapping keys, each always with the same value
+            for (uint64_t k = t * 500; k < t * 500 + 2000; k++) {
+                uint64_t v;
+                if (cache.lookup(k, v)) {
+                    EXPECT_EQ(v, k * k);
+                } else {
+                    cache.insert(k, k * k);
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (uint64_t k = 0; k < 3500; k++) {
+        uint64_t v;
+        ASSERT_TRUE(cache.lookup(k, v));
+        EXPECT_EQ(v, k * k);
+    }
+    EXPECT_EQ(cache.size(), 3500u);
+}
+
+TEST(test_ShardedLRUCache, clock_lookups_share_a_shard) {
+    // one shard, so that every lookup of every thread goes through the same lock
+    Cache::ShardedLRUCache<uint64_t, uint64_t, 1, std::hash<uint64_t>, Cache::Eviction::CLOCK> cache(256);
+    for (uint64_t k = 0; k < 256; k++) {
+        cache.insert(k, k * k);
+    }
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; t++) {
+        threads.emplace_back([&cache, t]() {
+            for (uint64_t i = 0; i < 20000; i++) {
+                const uint64_t k = (i * 7 + t) % 256;
+                uint64_t v;
+                if (cache.lookup(k, v)) {
+                    EXPECT_EQ(v, k * k);
+                } else {
+                    cache.insert(k, k * k);
+                }
+                // now and then, something new comes in and pushes an item out
+                if (i % 1000 == 0) {
+                    cache.insert(1000 + t * 100 + i / 1000, 0);
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(cache.size(), 256u);
+}
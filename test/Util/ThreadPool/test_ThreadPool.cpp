@@ -0,0 +1,142 @@
+/*
+ * Copyright 2025 Curtis Barnhart (cbarnhart@westmont.edu)
+ * This file is part of hex-ai.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hex-ai/Util/ThreadPool.hpp"
+
+TEST(test_ThreadPool, runs_every_task) {
+    for (unsigned threads : { 1u, 2u, 4u }) {
+        Util::ThreadPool pool(threads);
+        std::vector<std::atomic<int>> ran(1000);
+        {
+            Util::ThreadPool::TaskGroup group(pool);
+            for (std::atomic<int> &r : ran) {
+                group.run([&r] { r.fetch_add(1); });
+            }
+            group.wait();
+        }
+        for (const std::atomic<int> &r : ran) {
+            EXPECT_EQ(r.load(), 1)
+                << "A task did not run exactly once on " << threads << " threads.";
+        }
+    }
+}
+
+// sum 1 through n by splitting the range in half, waiting on each half
+long nested_sum(Util::ThreadPool &pool, long low, long high) {
+    if (high - low < 8) {
+        long sum = 0;
+        for (long i = low; i < high; i++) {
+            sum += i;
+        }
+        return sum;
+    }
+    const long middle = (low + high) / 2;
+    long left = 0, right = 0;
+    Util::ThreadPool::TaskGroup group(pool);
+    group.run([&] { left = nested_sum(pool, low, middle); });
+    group.run([&] { right = nested_sum(pool, middle, high); });
+    group.wait();
+    return left + right;
+}
+
+TEST(test_ThreadPool, nested_groups) {
+    // every task waits on tasks of its own, which must not tie up the pool
+    for (unsigned threads : { 1u, 3u }) {
+        Util::ThreadPool pool(threads);
+        EXPECT_EQ(nested_sum(pool, 0, 10000), 10000L * 9999 / 2);
+    }
+}
+
+TEST(test_ThreadPool, wait_runs_only_its_own_tasks) {
+    Util::ThreadPool pool(1);
+    std::atomic<bool> started = false, release = false, other_ran = false, mine_ran = false;
+    // keep the only worker busy, so that only the waiting thread can run anything
+    pool.submit([&] {
+        started.store(true);
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+
+    Util::ThreadPool::TaskGroup other(pool);
+    other.run([&] { other_ran.store(true); });
+    {
+        Util::ThreadPool::TaskGroup mine(pool);
+        mine.run([&] { mine_ran.store(true); });
+        mine.wait();
+    }
+    EXPECT_TRUE(mine_ran.load());
+    EXPECT_FALSE(other_ran.load()) << "Waiting on a group ran a task of another group.";
+
+    release.store(true);
+    other.wait();
+    EXPECT_TRUE(other_ran.load());
+}
+
+TEST(test_ThreadPool, wait_sleeps_until_a_running_task_finishes) {
+    Util::ThreadPool pool(1);
+    std::atomic<bool> started = false, finished = false;
+    Util::ThreadPool::TaskGroup group(pool);
+    // the worker takes the task, so the waiting thread has nothing to run
+    group.run([&] {
+        started.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished.store(true);
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+    group.wait();
+    EXPECT_TRUE(finished.load()) << "wait returned before the group's task finished.";
+}
+
+TEST(test_ThreadPool, wait_throws_what_a_task_threw) {
+    for (unsigned threads : { 1u, 2u }) {
+        Util::ThreadPool pool(threads);
+        std::atomic<int> ran = 0;
+        Util::ThreadPool::TaskGroup group(pool);
+        for (int i = 0; i < 10; i++) {
+            group.run([&ran, i] {
+                ran.fetch_add(1);
+                if (i == 3) {
+                    throw std::runtime_error("task failed");
+                }
+            });
+        }
+        EXPECT_THROW(group.wait(), std::runtime_error);
+        EXPECT_EQ(ran.load(), 10) << "A task that threw kept the group from finishing.";
+        // the exception was handed over, so the group is done with it
+        EXPECT_NO_THROW(group.wait());
+    }
+}
+
+TEST(test_ThreadPool, destructor_finishes_tasks) {
+    std::atomic<int> ran = 0;
+    {
+        Util::ThreadPool pool(2);
+        for (int i = 0; i < 100; i++) {
+            pool.submit([&ran] { ran.fetch_add(1); });
+        }
+    }
+    EXPECT_EQ(ran.load(), 100);
+}
+
+TEST(test_ThreadPool, size) {
+    EXPECT_EQ(Util::ThreadPool(3).size(), 3u);
+    EXPECT_EQ(Util::ThreadPool(0).size(), 1u)
+        << "A pool must have at least one worker.";
+}